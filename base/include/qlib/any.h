@@ -0,0 +1 @@
+#include "qlib/any.hpp"
\ No newline at end of file
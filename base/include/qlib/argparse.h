@@ -0,0 +1 @@
+#include "qlib/argparse.hpp"
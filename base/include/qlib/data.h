@@ -0,0 +1 @@
+#include "qlib/data.hpp"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "qlib/format.hpp"
\ No newline at end of file
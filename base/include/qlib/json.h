@@ -0,0 +1 @@
+#include "qlib/json.hpp"
@@ -0,0 +1 @@
+#include "qlib/logger.hpp"
@@ -0,0 +1 @@
+#include "qlib/memory.hpp"
\ No newline at end of file
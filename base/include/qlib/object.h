@@ -0,0 +1 @@
+#include "qlib/object.hpp"
@@ -0,0 +1 @@
+#include "qlib/string.hpp"
\ No newline at end of file
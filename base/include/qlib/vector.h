@@ -0,0 +1 @@
+#include "qlib/vector.hpp"
\ No newline at end of file
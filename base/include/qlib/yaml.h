@@ -0,0 +1 @@
+#include "qlib/yaml.hpp"
@@ -4,12 +4,17 @@
 #include <fstream>
 // #include <iostream>
 #include <charconv>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #ifdef HAS_NLOHMANN_JSON
 #include "nlohmann/json.hpp"
 #endif
+#include "qlib/cbor.h"
 #include "qlib/json.h"
+#include "qlib/msgpack.h"
 #include "qlib/string.h"
 
 constexpr static inline auto resources_path = RESOUCES_PATH;
@@ -37,7 +42,9 @@ using namespace qlib;
 // }
 
 template <class JsonType>
-static auto json_parse(std::string const& filepath, benchmark::State& state) {
+static auto json_parse(std::string const& filepath,
+                       benchmark::State& state,
+                       json::parse_option options = json::parse_default) {
     std::ifstream file{filepath};
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open file: " + filepath);
@@ -48,7 +55,7 @@ static auto json_parse(std::string const& filepath, benchmark::State& state) {
     for (auto _ : state) {
         typename JsonType::allocator_type pool;
         JsonType json(pool);
-        auto result = json::parse(&json, begin, end);
+        auto result = json::parse(&json, begin, end, options);
         benchmark::DoNotOptimize(result);
         benchmark::DoNotOptimize(json);
     }
@@ -102,6 +109,184 @@ static auto benchmark_json_view_pool_parse_twitter(benchmark::State& state) {
     json_parse<json_view_pool_t>(twitter_json, state);
 }
 
+static auto benchmark_json_view_pool_two_stage_parse_canada(benchmark::State& state) {
+    json_parse<json_view_pool_t>(canada_json, state, json::parse_two_stage);
+}
+
+static auto benchmark_json_view_pool_two_stage_parse_citm_catalog(benchmark::State& state) {
+    json_parse<json_view_pool_t>(citm_catalog_json, state, json::parse_two_stage);
+}
+
+static auto benchmark_json_view_pool_two_stage_parse_twitter(benchmark::State& state) {
+    json_parse<json_view_pool_t>(twitter_json, state, json::parse_two_stage);
+}
+
+static auto benchmark_json_view_pool_exact_parse_canada(benchmark::State& state) {
+    json_parse<json_view_pool_t>(canada_json, state, json::parse_exact_capacity);
+}
+
+static auto benchmark_json_view_pool_exact_parse_citm_catalog(benchmark::State& state) {
+    json_parse<json_view_pool_t>(citm_catalog_json, state, json::parse_exact_capacity);
+}
+
+static auto benchmark_json_view_pool_exact_parse_twitter(benchmark::State& state) {
+    json_parse<json_view_pool_t>(twitter_json, state, json::parse_exact_capacity);
+}
+
+static auto benchmark_json_tape_parse_canada(benchmark::State& state) {
+    json_parse<json_tape_t>(canada_json, state);
+}
+
+static auto benchmark_json_tape_parse_citm_catalog(benchmark::State& state) {
+    json_parse<json_tape_t>(citm_catalog_json, state);
+}
+
+static auto benchmark_json_tape_parse_twitter(benchmark::State& state) {
+    json_parse<json_tape_t>(twitter_json, state);
+}
+
+/* 驻留表在多次解析之间共享, 首次之后所有的键都命中 */
+template <class JsonType>
+static auto json_intern_parse(std::string const& filepath, benchmark::State& state) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto begin = text.data();
+    auto end = begin + text.size();
+    json_intern_t table;
+    for (auto _ : state) {
+        typename JsonType::allocator_type pool;
+        JsonType json(pool);
+        auto result = json::parse(&json, begin, end, json::parse_default, table);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(json);
+    }
+    state.counters["keys"] = double(table.size());
+}
+
+static auto benchmark_json_view_pool_intern_parse_citm_catalog(benchmark::State& state) {
+    json_intern_parse<json_view_pool_t>(citm_catalog_json, state);
+}
+
+static auto benchmark_json_view_pool_intern_parse_twitter(benchmark::State& state) {
+    json_intern_parse<json_view_pool_t>(twitter_json, state);
+}
+
+/* 分配器与层级栈在多次解析之间复用, 对比每次新建分配器的 json_parse */
+template <class JsonType>
+static auto json_context_parse(std::string const& filepath,
+                               benchmark::State& state,
+                               json::parse_option options = json::parse_default) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto begin = text.data();
+    auto end = begin + text.size();
+    json::parse_context<JsonType> context(options);
+    for (auto _ : state) {
+        auto result = context.parse(begin, end);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(context.document());
+    }
+    state.counters["peak_bytes"] = double(context.stats().peak_bytes);
+    state.counters["capacity"] = double(context.stats().capacity);
+}
+
+static auto benchmark_json_view_pool_context_parse_canada(benchmark::State& state) {
+    json_context_parse<json_view_pool_t>(canada_json, state);
+}
+
+static auto benchmark_json_view_pool_context_parse_citm_catalog(benchmark::State& state) {
+    json_context_parse<json_view_pool_t>(citm_catalog_json, state);
+}
+
+static auto benchmark_json_view_pool_context_parse_twitter(benchmark::State& state) {
+    json_context_parse<json_view_pool_t>(twitter_json, state);
+}
+
+static auto benchmark_json_view_pool_exact_context_parse_canada(benchmark::State& state) {
+    json_context_parse<json_view_pool_t>(canada_json, state, json::parse_exact_capacity);
+}
+
+/* 只校验不建树 */
+static auto json_validate(std::string const& filepath, benchmark::State& state) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    for (auto _ : state) {
+        auto result = json::validate(text.data(), text.data() + text.size());
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * qlib::int64_t(text.size()));
+}
+
+static auto benchmark_json_validate_canada(benchmark::State& state) {
+    json_validate(canada_json, state);
+}
+
+static auto benchmark_json_validate_citm_catalog(benchmark::State& state) {
+    json_validate(citm_catalog_json, state);
+}
+
+static auto benchmark_json_validate_twitter(benchmark::State& state) {
+    json_validate(twitter_json, state);
+}
+
+static auto benchmark_json_compact_parse_canada(benchmark::State& state) {
+    json_parse<json_compact_t>(canada_json, state);
+}
+
+static auto benchmark_json_compact_parse_citm_catalog(benchmark::State& state) {
+    json_parse<json_compact_t>(citm_catalog_json, state);
+}
+
+static auto benchmark_json_compact_parse_twitter(benchmark::State& state) {
+    json_parse<json_compact_t>(twitter_json, state);
+}
+
+/* 解析后 pool 中占用的字节数, ratio 为相对输入大小的倍数 */
+template <class JsonType>
+static auto json_memory(std::string const& filepath,
+                        benchmark::State& state,
+                        json::parse_option options = json::parse_default) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto begin = text.data();
+    auto end = begin + text.size();
+    size_t used{0u};
+    for (auto _ : state) {
+        typename JsonType::allocator_type pool;
+        JsonType json(pool);
+        auto result = json::parse(&json, begin, end, options);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(json);
+        used = pool.used();
+    }
+    state.counters["bytes"] = double(used);
+    state.counters["ratio"] = double(used) / double(text.size());
+}
+
+static auto benchmark_json_view_pool_memory_canada(benchmark::State& state) {
+    json_memory<json_view_pool_t>(canada_json, state);
+}
+
+static auto benchmark_json_view_pool_exact_memory_canada(benchmark::State& state) {
+    json_memory<json_view_pool_t>(canada_json, state, json::parse_exact_capacity);
+}
+
+static auto benchmark_json_compact_memory_canada(benchmark::State& state) {
+    json_memory<json_compact_t>(canada_json, state);
+}
+
 #ifdef HAS_NLOHMANN_JSON
 static auto benchmark_nlohmann_json_parse_canada(benchmark::State& state) {
     std::ifstream file(canada_json);
@@ -140,6 +325,482 @@ static auto benchmark_nlohmann_json_parse_twitter(benchmark::State& state) {
 }
 #endif
 
+static auto benchmark_json_view_pool_validate_utf8_parse_twitter(benchmark::State& state) {
+    json_parse<json_view_pool_t>(twitter_json, state, json::parse_validate_utf8);
+}
+
+template <class JsonType>
+static size_t json_unescape(JsonType const& node) {
+    size_t size{0u};
+    switch (node.type()) {
+        case json::value_enum::object: {
+            for (auto& item : node.object()) {
+                size += json_unescape(item.value);
+            }
+            break;
+        }
+        case json::value_enum::array: {
+            for (auto& item : node.array()) {
+                size += json_unescape(item);
+            }
+            break;
+        }
+        case json::value_enum::string: {
+            size += node.template get<string_t>().size();
+            break;
+        }
+        default:
+            break;
+    }
+    return size;
+}
+
+/* 解码全部字符串: twitter.json 以非 ASCII 文本为主, 转义稀疏 */
+static auto benchmark_json_view_unescape_twitter(benchmark::State& state) {
+    std::ifstream file{twitter_json};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + twitter_json);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    json_view_t value;
+    json::parse(&value, text.data(), text.data() + text.size());
+    for (auto _ : state) {
+        auto size = json_unescape(value);
+        benchmark::DoNotOptimize(size);
+    }
+}
+
+struct twitter_user {
+    string_view_t screen_name;
+    qlib::uint64_t followers_count{0u};
+};
+
+struct twitter_status {
+    qlib::uint64_t id{0u};
+    string_t text;
+    twitter_user user;
+    qlib::uint32_t retweet_count{0u};
+    bool_t favorited{False};
+};
+
+struct twitter_statuses {
+    vector_t<twitter_status> statuses;
+};
+
+namespace qlib {
+namespace json {
+template <>
+struct binding<twitter_user> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("screen_name", value.screen_name);
+        func("followers_count", value.followers_count);
+    }
+};
+
+template <>
+struct binding<twitter_status> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("id", value.id);
+        func("text", value.text);
+        func("user", value.user);
+        func("retweet_count", value.retweet_count);
+        func("favorited", value.favorited);
+    }
+};
+
+template <>
+struct binding<twitter_statuses> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("statuses", value.statuses);
+    }
+};
+};  // namespace json
+};  // namespace qlib
+
+static auto benchmark_json_decode_twitter(benchmark::State& state) {
+    std::ifstream file{twitter_json};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + twitter_json);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    for (auto _ : state) {
+        twitter_statuses value;
+        auto result = json::decode(&value, text.data(), text.data() + text.size());
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+/* 对照: 先解析为 json_view_t, 再逐个成员复制到同样的结构体 */
+static auto benchmark_json_view_extract_twitter(benchmark::State& state) {
+    std::ifstream file{twitter_json};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + twitter_json);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    for (auto _ : state) {
+        json_view_t json;
+        auto result = json::parse(&json, text.data(), text.data() + text.size());
+        twitter_statuses value;
+        for (auto& item : json["statuses"].array()) {
+            value.statuses.emplace_back();
+            auto& status = value.statuses.back();
+            status.id = item["id"].get<qlib::uint64_t>();
+            status.text = item["text"].get<string_t>();
+            status.user.screen_name = item["user"]["screen_name"].get<string_view_t>();
+            status.user.followers_count = item["user"]["followers_count"].get<qlib::uint64_t>();
+            status.retweet_count = item["retweet_count"].get<qlib::uint32_t>();
+            status.favorited = item["favorited"].get<bool_t>();
+        }
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+enum class codec { text, msgpack, cbor };
+
+/* 把解析好的 json_t 编码后再解码到 json_view_pool_t, bytes 为编码后的大小 */
+template <codec Codec>
+static auto json_round_trip(std::string const& filepath, benchmark::State& state) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    json_t json;
+    if (json::parse(&json, text.data(), text.data() + text.size()) != 0) {
+        throw std::runtime_error("Failed to parse file: " + filepath);
+    }
+    string_t buffer(text.size());
+    for (auto _ : state) {
+        buffer.clear();
+        json_view_pool_t::allocator_type pool;
+        json_view_pool_t value(pool);
+        int32_t result;
+        if constexpr (Codec == codec::text) {
+            json.to(buffer);
+            result = json::parse(&value, buffer.begin(), buffer.end());
+        } else if constexpr (Codec == codec::msgpack) {
+            msgpack::to(json, buffer);
+            result = msgpack::parse(&value, buffer.begin(), buffer.end());
+        } else {
+            cbor::to(json, buffer);
+            result = cbor::parse(&value, buffer.begin(), buffer.end());
+        }
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(value);
+    }
+    state.counters["bytes"] = double(buffer.size());
+}
+
+static auto benchmark_json_text_round_trip_canada(benchmark::State& state) {
+    json_round_trip<codec::text>(canada_json, state);
+}
+
+static auto benchmark_json_msgpack_round_trip_canada(benchmark::State& state) {
+    json_round_trip<codec::msgpack>(canada_json, state);
+}
+
+static auto benchmark_json_cbor_round_trip_canada(benchmark::State& state) {
+    json_round_trip<codec::cbor>(canada_json, state);
+}
+
+static auto benchmark_json_text_round_trip_citm_catalog(benchmark::State& state) {
+    json_round_trip<codec::text>(citm_catalog_json, state);
+}
+
+static auto benchmark_json_msgpack_round_trip_citm_catalog(benchmark::State& state) {
+    json_round_trip<codec::msgpack>(citm_catalog_json, state);
+}
+
+static auto benchmark_json_cbor_round_trip_citm_catalog(benchmark::State& state) {
+    json_round_trip<codec::cbor>(citm_catalog_json, state);
+}
+
+static auto benchmark_json_text_round_trip_twitter(benchmark::State& state) {
+    json_round_trip<codec::text>(twitter_json, state);
+}
+
+static auto benchmark_json_msgpack_round_trip_twitter(benchmark::State& state) {
+    json_round_trip<codec::msgpack>(twitter_json, state);
+}
+
+static auto benchmark_json_cbor_round_trip_twitter(benchmark::State& state) {
+    json_round_trip<codec::cbor>(twitter_json, state);
+}
+
+/* 结构比较与旧的 "序列化后比较文本" 做对照 */
+template <int32_t Mode>
+static auto json_equal(std::string const& filepath, benchmark::State& state) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    json_t json;
+    json_view_t view;
+    if (json::parse(&json, text.data(), text.data() + text.size()) != 0 ||
+        json::parse(&view, text.data(), text.data() + text.size()) != 0) {
+        throw std::runtime_error("Failed to parse file: " + filepath);
+    }
+    auto compact = json.to();
+    for (auto _ : state) {
+        bool_t result;
+        if constexpr (Mode == 0) {
+            result = json == view;
+        } else if constexpr (Mode == 1) {
+            result = json == string_view_t(text.data(), text.data() + text.size());
+        } else {
+            result = view.to() == string_view_t(compact.begin(), compact.end());
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static auto benchmark_json_equal_twitter(benchmark::State& state) {
+    json_equal<0>(twitter_json, state);
+}
+
+static auto benchmark_json_equal_text_twitter(benchmark::State& state) {
+    json_equal<1>(twitter_json, state);
+}
+
+static auto benchmark_json_to_equal_twitter(benchmark::State& state) {
+    json_equal<2>(twitter_json, state);
+}
+
+/* 一条消息分发给 8 个订阅者, 每个订阅者修改其中一个字段: json_t 深拷贝, frozen 只复制路径 */
+template <int32_t Mode>
+static auto json_fan_out(std::string const& filepath, benchmark::State& state) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    json_t json;
+    if (json::parse(&json, text.data(), text.data() + text.size()) != 0) {
+        throw std::runtime_error("Failed to parse file: " + filepath);
+    }
+    json_frozen_t frozen(json);
+    json::pointer<> path("/search_metadata/count");
+    json_frozen_t count(json_t(1));
+    for (auto _ : state) {
+        for (auto i = 0; i < 8; ++i) {
+            if constexpr (Mode == 0) {
+                json_t copy(json);
+                copy["search_metadata"]["count"] = 1;
+                benchmark::DoNotOptimize(copy);
+            } else {
+                auto copy = frozen.set(path, count);
+                benchmark::DoNotOptimize(copy);
+            }
+        }
+    }
+}
+
+static auto benchmark_json_copy_fan_out_twitter(benchmark::State& state) {
+    json_fan_out<0>(twitter_json, state);
+}
+
+static auto benchmark_json_frozen_fan_out_twitter(benchmark::State& state) {
+    json_fan_out<1>(twitter_json, state);
+}
+
+/* 小的更新: 直接对树执行 JSON Patch, 对照序列化后修改再解析; diff 只输出有变化的路径 */
+template <int32_t Mode>
+static auto json_patch(std::string const& filepath, benchmark::State& state) {
+    std::ifstream file{filepath};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    json_t json;
+    if (json::parse(&json, text.data(), text.data() + text.size()) != 0) {
+        throw std::runtime_error("Failed to parse file: " + filepath);
+    }
+    string_t ops(R"([{"op":"replace","path":"/search_metadata/count","value":1},)"
+                 R"({"op":"add","path":"/statuses/0/user/tag","value":"x"}])");
+    json_t patch;
+    json::parse(&patch, ops.begin(), ops.end());
+    json_t target(json);
+    json::apply_patch(&target, patch);
+    for (auto _ : state) {
+        if constexpr (Mode == 0) {
+            auto result = json::apply_patch(&json, patch);
+            benchmark::DoNotOptimize(result);
+        } else if constexpr (Mode == 1) {
+            auto out = json.to();
+            json_t copy;
+            auto result = json::parse(&copy, out.begin(), out.end());
+            copy["search_metadata"]["count"] = 1;
+            copy["statuses"].array()[0u]["user"]["tag"] = "x";
+            benchmark::DoNotOptimize(result);
+        } else {
+            json_t changes;
+            json::diff(&changes, json, target);
+            benchmark::DoNotOptimize(changes);
+        }
+    }
+}
+
+static auto benchmark_json_apply_patch_twitter(benchmark::State& state) {
+    json_patch<0>(twitter_json, state);
+}
+
+static auto benchmark_json_reparse_patch_twitter(benchmark::State& state) {
+    json_patch<1>(twitter_json, state);
+}
+
+static auto benchmark_json_diff_twitter(benchmark::State& state) {
+    json_patch<2>(twitter_json, state);
+}
+
+static auto benchmark_json_lines_twitter(benchmark::State& state) {
+    std::ifstream file{twitter_json};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + twitter_json);
+    }
+    std::string twitter((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    json_t value;
+    json::parse(&value, twitter.data(), twitter.data() + twitter.size());
+
+    /* 每条 status 一行, 重复 100 次 */
+    std::string text;
+    auto sink = json::make_sink([&text](char const* data, size_t size) { text.append(data, size); });
+    {
+        json::writer<decltype(sink)> writer(sink);
+        for (auto i = 0; i < 100; ++i) {
+            for (auto& status : value["statuses"].array()) {
+                writer.write(status);
+            }
+        }
+    }
+
+    auto threads = uint32_t(state.range(0));
+    for (auto _ : state) {
+        json::lines_reader<json_view_pool_t> reader(text.data(), text.data() + text.size());
+        reader.for_each([](json::lines_reader<json_view_pool_t>::document& doc) {
+            benchmark::DoNotOptimize(doc);
+        }, threads, True);
+    }
+    state.SetBytesProcessed(state.iterations() * qlib::int64_t(text.size()));
+}
+
+/* 每条 status 作为一条独立的消息, 与 lines_reader 的数据相同 */
+static auto benchmark_json_batch_twitter(benchmark::State& state) {
+    std::ifstream file{twitter_json};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + twitter_json);
+    }
+    std::string twitter((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    json_t value;
+    json::parse(&value, twitter.data(), twitter.data() + twitter.size());
+
+    std::vector<std::string> messages;
+    size_t bytes{0u};
+    for (auto i = 0; i < 100; ++i) {
+        for (auto& status : value["statuses"].array()) {
+            string_t text;
+            status.to(text);
+            messages.emplace_back(text.begin(), text.end());
+            bytes += text.size();
+        }
+    }
+    std::vector<string_view_t> inputs;
+    for (auto& message : messages) {
+        inputs.emplace_back(message.data(), message.data() + message.size());
+    }
+
+    json::batch_parser<json_view_pool_t> batch(uint32_t(state.range(0)));
+    for (auto _ : state) {
+        auto& results = json::parse_batch(batch, inputs.data(), inputs.data() + inputs.size());
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetBytesProcessed(state.iterations() * qlib::int64_t(bytes));
+    state.SetItemsProcessed(state.iterations() * qlib::int64_t(inputs.size()));
+}
+
+/* twitter 中的 11 个路径: 链式 operator[], 预编译的 pointer, 直接对原文求值与一次扫描批量求值 */
+static auto twitter_paths() {
+    std::vector<std::string> paths;
+    for (auto i = 0; i < 100; i += 10) {
+        paths.emplace_back("/statuses/" + std::to_string(i) + "/user/screen_name");
+    }
+    paths.emplace_back("/search_metadata/count");
+    return paths;
+}
+
+static auto read_twitter() {
+    std::ifstream file{twitter_json};
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + twitter_json);
+    }
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static auto benchmark_json_chain_lookup_twitter(benchmark::State& state) {
+    auto text = read_twitter();
+    json_t value;
+    json::parse(&value, text.data(), text.data() + text.size());
+    json_t const& json = value;
+    for (auto _ : state) {
+        for (auto i = 0u; i < 100u; i += 10u) {
+            auto& name = json["statuses"].array()[i]["user"]["screen_name"];
+            benchmark::DoNotOptimize(name);
+        }
+        auto& count = json["search_metadata"]["count"];
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+static auto benchmark_json_pointer_resolve_twitter(benchmark::State& state) {
+    auto text = read_twitter();
+    json_t value;
+    json::parse(&value, text.data(), text.data() + text.size());
+    std::vector<json::pointer<>> pointers;
+    for (auto& path : twitter_paths()) {
+        pointers.emplace_back(string_view_t(path.data(), path.data() + path.size()));
+    }
+    for (auto _ : state) {
+        for (auto& pointer : pointers) {
+            auto node = pointer.resolve(value);
+            benchmark::DoNotOptimize(node);
+        }
+    }
+}
+
+static auto benchmark_json_pointer_text_twitter(benchmark::State& state) {
+    auto text = read_twitter();
+    std::vector<json::pointer<>> pointers;
+    for (auto& path : twitter_paths()) {
+        pointers.emplace_back(string_view_t(path.data(), path.data() + path.size()));
+    }
+    for (auto _ : state) {
+        for (auto& pointer : pointers) {
+            auto view = pointer.resolve(text.data(), text.data() + text.size());
+            benchmark::DoNotOptimize(view);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * qlib::int64_t(text.size()));
+}
+
+static auto benchmark_json_pointer_set_twitter(benchmark::State& state) {
+    auto text = read_twitter();
+    json::pointer_set<> set;
+    for (auto& path : twitter_paths()) {
+        set.add(string_view_t(path.data(), path.data() + path.size()));
+    }
+    vector_t<json::document_view<char>> results;
+    for (auto _ : state) {
+        set.extract(text.data(), text.data() + text.size(), results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetBytesProcessed(state.iterations() * qlib::int64_t(text.size()));
+}
+
 #define DECLARE_VALUE()                                                                            \
     auto build_type = json_type::object({{"type", "STRING"}, {"value", "Release"}});               \
     auto install_prefix =                                                                          \
@@ -235,6 +896,20 @@ static auto benchmark_json_view_to(benchmark::State& state) {
     }
 }
 
+static auto benchmark_json_writer(benchmark::State& state) {
+    size_t size{0u};
+    auto sink = json::make_sink([&size](char const*, size_t n) { size += n; });
+    json::writer<decltype(sink)> writer(sink, 0u, 4096u);
+    for (auto _ : state) {
+        using json_type = json_t;
+        DECLARE_VALUE();
+        benchmark::DoNotOptimize(value);
+        writer.write(value);
+        writer.flush();
+        benchmark::DoNotOptimize(size);
+    }
+}
+
 #ifdef HAS_NLOHMANN_JSON
 static auto benchmark_nlohmann_json_to(benchmark::State& state) {
     for (auto _ : state) {
@@ -269,6 +944,16 @@ int32_t main(int32_t argc, char* argv[]) {
         BENCHMARK(benchmark_json_pool_parse_canada)->Iterations(_iterations);
         BENCHMARK(benchmark_json_view_parse_canada)->Iterations(_iterations);
         BENCHMARK(benchmark_json_view_pool_parse_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_two_stage_parse_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_exact_parse_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_context_parse_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_exact_context_parse_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_tape_parse_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_compact_parse_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_validate_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_memory_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_exact_memory_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_compact_memory_canada)->Iterations(_iterations);
 #ifdef HAS_NLOHMANN_JSON
         BENCHMARK(benchmark_nlohmann_json_parse_canada)->Iterations(_iterations);
 #endif
@@ -276,6 +961,13 @@ int32_t main(int32_t argc, char* argv[]) {
         BENCHMARK(benchmark_json_view_parse_citm_catalog)->Iterations(_iterations);
         BENCHMARK(benchmark_json_pool_parse_citm_catalog)->Iterations(_iterations);
         BENCHMARK(benchmark_json_view_pool_parse_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_two_stage_parse_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_exact_parse_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_context_parse_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_tape_parse_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_compact_parse_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_validate_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_intern_parse_citm_catalog)->Iterations(_iterations);
 #ifdef HAS_NLOHMANN_JSON
         BENCHMARK(benchmark_nlohmann_json_parse_citm_catalog)->Iterations(_iterations);
 #endif
@@ -283,11 +975,46 @@ int32_t main(int32_t argc, char* argv[]) {
         BENCHMARK(benchmark_json_view_parse_twitter)->Iterations(_iterations);
         BENCHMARK(benchmark_json_pool_parse_twitter)->Iterations(_iterations);
         BENCHMARK(benchmark_json_view_pool_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_two_stage_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_exact_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_context_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_tape_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_compact_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_validate_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_intern_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_pool_validate_utf8_parse_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_unescape_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_decode_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_view_extract_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_chain_lookup_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_pointer_resolve_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_pointer_text_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_pointer_set_twitter)->Iterations(_iterations);
 #ifdef HAS_NLOHMANN_JSON
         BENCHMARK(benchmark_nlohmann_json_parse_twitter)->Iterations(_iterations);
 #endif
+        BENCHMARK(benchmark_json_text_round_trip_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_msgpack_round_trip_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_cbor_round_trip_canada)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_text_round_trip_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_msgpack_round_trip_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_cbor_round_trip_citm_catalog)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_text_round_trip_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_msgpack_round_trip_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_cbor_round_trip_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_equal_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_equal_text_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_to_equal_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_copy_fan_out_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_frozen_fan_out_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_apply_patch_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_reparse_patch_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_diff_twitter)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_lines_twitter)->Arg(1)->Arg(4)->Iterations(_iterations / 100u + 1u);
+        BENCHMARK(benchmark_json_batch_twitter)->Arg(1)->Arg(4)->Iterations(_iterations / 100u + 1u);
         BENCHMARK(benchmark_json_to)->Iterations(_iterations);
         BENCHMARK(benchmark_json_view_to)->Iterations(_iterations);
+        BENCHMARK(benchmark_json_writer)->Iterations(_iterations);
 #ifdef HAS_NLOHMANN_JSON
         BENCHMARK(benchmark_nlohmann_json_to)->Iterations(_iterations);
 #endif
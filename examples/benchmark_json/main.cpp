@@ -0,0 +1,400 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef HAS_NLOHMANN_JSON
+#include "nlohmann/json.hpp"
+#endif
+#include "qlib/json.h"
+#include "qlib/string.h"
+
+constexpr static inline auto resources_path = RESOUCES_PATH;
+
+using namespace qlib;
+
+/* 替换全局 new/delete 统计堆上的当前与峰值字节数, 每块前置一个头记录原始指针与大小;
+ * pool_allocator 的块同样经过这里, 因此四种别名与 nlohmann 使用同一把尺子.
+ * 对齐的 new 按 align 对齐用户指针, 头仍紧贴在它前面.
+ * 释放不内联: 调用方对 0 字节 memmove 的推断不能消掉这里的空指针检查 */
+namespace {
+std::atomic<size_t> heap_current{0u};
+std::atomic<size_t> heap_peak{0u};
+constexpr size_t heap_header = alignof(std::max_align_t);
+static_assert(heap_header >= sizeof(void*) + sizeof(size_t), "heap header too small");
+
+void* heap_allocate(size_t n, size_t align) {
+    align = std::max(align, heap_header);
+    auto base = (uint8_t*)std::malloc(n + heap_header + align);
+    if (base == nullptr) {
+        throw std::bad_alloc();
+    }
+    auto p = (uint8_t*)((uintptr_t(base) + heap_header + align - 1u) & ~uintptr_t(align - 1u));
+    ((void**)(p - heap_header))[0] = base;
+    ((size_t*)p)[-1] = n;
+    auto current = heap_current.fetch_add(n, std::memory_order_relaxed) + n;
+    auto peak = heap_peak.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !heap_peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+    return p;
+}
+
+__attribute__((noinline)) void heap_free(void* p) noexcept {
+    if (p != nullptr) {
+        heap_current.fetch_sub(((size_t*)p)[-1], std::memory_order_relaxed);
+        std::free(((void**)((uint8_t*)p - heap_header))[0]);
+    }
+}
+};  // namespace
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t n) { return heap_allocate(n, heap_header); }
+void* operator new[](size_t n) { return heap_allocate(n, heap_header); }
+void* operator new(size_t n, std::align_val_t align) { return heap_allocate(n, size_t(align)); }
+void* operator new[](size_t n, std::align_val_t align) { return heap_allocate(n, size_t(align)); }
+
+void operator delete(void* p) noexcept { heap_free(p); }
+void operator delete[](void* p) noexcept { heap_free(p); }
+void operator delete(void* p, size_t) noexcept { heap_free(p); }
+void operator delete[](void* p, size_t) noexcept { heap_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { heap_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { heap_free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { heap_free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { heap_free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+enum file : int32_t { canada, citm_catalog, twitter };
+
+static std::string const& load(file f) {
+    static std::string texts[3];
+    constexpr char const* names[] = {"/canada.json", "/citm_catalog.json", "/twitter.json"};
+    auto& text = texts[f];
+    if (text.empty()) {
+        auto filepath = std::string(resources_path) + names[f];
+        std::ifstream file{filepath};
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filepath);
+        }
+        text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    return text;
+}
+
+/* 统一各实现的解析, 遍历, 查找与序列化; view 策略引用输入, text 需比文档活得久 */
+template <class Json>
+struct document {
+    using json_type = Json;
+    using out_type = string_t;
+
+    typename Json::allocator_type allocator;
+    Json json;
+
+    document() : json(allocator) {}
+
+    int32_t parse(std::string const& text) {
+        return json::parse(&json, text.data(), text.data() + text.size());
+    }
+
+    void to(out_type& out) const { json.to(out); }
+
+    static void walk(Json const& json, size_t& nodes, double& sum) {
+        ++nodes;
+        switch (json.type()) {
+            case json::value_enum::object: {
+                for (auto& it : json.object()) {
+                    walk(it.value, nodes, sum);
+                }
+                break;
+            }
+            case json::value_enum::array: {
+                for (auto& it : json.array()) {
+                    walk(it, nodes, sum);
+                }
+                break;
+            }
+            case json::value_enum::number:
+            case json::value_enum::number_ref: {
+                sum += json.template get<double>();
+                break;
+            }
+            default:;
+        }
+    }
+
+    static void collect(Json& json, std::vector<std::pair<Json*, std::string>>& keys) {
+        if (json.type() == json::value_enum::object) {
+            for (auto& it : json.object()) {
+                keys.emplace_back(&json, std::string(it.key.data(), it.key.size()));
+                collect(it.value, keys);
+            }
+        } else if (json.type() == json::value_enum::array) {
+            for (auto& it : json.array()) {
+                collect(it, keys);
+            }
+        }
+    }
+
+    static bool_t find(Json& json, std::string const& key) {
+        return json.find(typename Json::string_view_t(key.data(), key.data() + key.size())) !=
+               json.object().end();
+    }
+};
+
+#ifdef HAS_NLOHMANN_JSON
+template <>
+struct document<nlohmann::json> {
+    using json_type = nlohmann::json;
+    using out_type = std::string;
+
+    json_type json;
+
+    int32_t parse(std::string const& text) {
+        json = json_type::parse(text, nullptr, false);
+        return json.is_discarded() ? -1 : 0;
+    }
+
+    void to(out_type& out) const { out = json.dump(); }
+
+    static void walk(json_type const& json, size_t& nodes, double& sum) {
+        ++nodes;
+        if (json.is_object()) {
+            for (auto it = json.begin(); it != json.end(); ++it) {
+                walk(it.value(), nodes, sum);
+            }
+        } else if (json.is_array()) {
+            for (auto& it : json) {
+                walk(it, nodes, sum);
+            }
+        } else if (json.is_number()) {
+            sum += json.get<double>();
+        }
+    }
+
+    static void collect(json_type& json, std::vector<std::pair<json_type*, std::string>>& keys) {
+        if (json.is_object()) {
+            for (auto it = json.begin(); it != json.end(); ++it) {
+                keys.emplace_back(&json, it.key());
+                collect(it.value(), keys);
+            }
+        } else if (json.is_array()) {
+            for (auto& it : json) {
+                collect(it, keys);
+            }
+        }
+    }
+
+    static bool_t find(json_type& json, std::string const& key) {
+        return json.find(key) != json.end();
+    }
+};
+#endif
+
+template <class Json, file File>
+static auto benchmark_parse(benchmark::State& state) {
+    auto& text = load(File);
+    for (auto _ : state) {
+        document<Json> doc;
+        auto result = doc.parse(text);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(doc.json);
+    }
+    state.SetBytesProcessed(::int64_t(state.iterations() * text.size()));
+}
+
+/* 访问全部节点并解码全部数值 */
+template <class Json, file File>
+static auto benchmark_traverse(benchmark::State& state) {
+    auto& text = load(File);
+    document<Json> doc;
+    if (doc.parse(text) != 0) {
+        state.SkipWithError("parse failed");
+        return;
+    }
+    size_t nodes{0u};
+    for (auto _ : state) {
+        nodes = 0u;
+        double sum{0.0};
+        document<Json>::walk(doc.json, nodes, sum);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(::int64_t(state.iterations() * nodes));
+}
+
+/* 按固定种子打乱文档中所有 (对象, 键), 逐个查找 */
+template <class Json, file File>
+static auto benchmark_lookup(benchmark::State& state) {
+    auto& text = load(File);
+    document<Json> doc;
+    if (doc.parse(text) != 0) {
+        state.SkipWithError("parse failed");
+        return;
+    }
+    std::vector<std::pair<Json*, std::string>> keys;
+    document<Json>::collect(doc.json, keys);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42u});
+    for (auto _ : state) {
+        size_t found{0u};
+        for (auto& it : keys) {
+            found += document<Json>::find(*it.first, it.second);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(::int64_t(state.iterations() * keys.size()));
+}
+
+template <class Json, file File>
+static auto benchmark_to(benchmark::State& state) {
+    auto& text = load(File);
+    document<Json> doc;
+    if (doc.parse(text) != 0) {
+        state.SkipWithError("parse failed");
+        return;
+    }
+    size_t size{0u};
+    for (auto _ : state) {
+        typename document<Json>::out_type out;
+        doc.to(out);
+        size = out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(::int64_t(state.iterations() * size));
+}
+
+/* 解析再序列化; 先检查一次输出能重新解析 */
+template <class Json, file File>
+static auto benchmark_round_trip(benchmark::State& state) {
+    auto& text = load(File);
+    {
+        document<Json> doc;
+        typename document<Json>::out_type out;
+        if (doc.parse(text) != 0) {
+            state.SkipWithError("parse failed");
+            return;
+        }
+        doc.to(out);
+        document<Json> again;
+        if (again.parse(std::string(out.data(), out.size())) != 0) {
+            state.SkipWithError("round trip failed");
+            return;
+        }
+    }
+    for (auto _ : state) {
+        document<Json> doc;
+        auto result = doc.parse(text);
+        typename document<Json>::out_type out;
+        doc.to(out);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(::int64_t(state.iterations() * text.size()));
+}
+
+/* peak 为解析过程中的堆峰值增量, bytes 为解析完成后文档仍占用的字节数, ratio 相对输入大小;
+ * pool 别名另报 used, 即 pool 中实际分配出去的字节数 */
+template <class Json, file File>
+static auto benchmark_memory(benchmark::State& state) {
+    auto& text = load(File);
+    size_t peak{0u};
+    size_t bytes{0u};
+    size_t used{0u};
+    for (auto _ : state) {
+        auto base = heap_current.load();
+        heap_peak.store(base);
+        {
+            document<Json> doc;
+            auto result = doc.parse(text);
+            benchmark::DoNotOptimize(result);
+            bytes = heap_current.load() - base;
+            if constexpr (std::is_same_v<typename Json::allocator_type, pool_allocator_t>) {
+                used = doc.allocator.used();
+            }
+        }
+        peak = heap_peak.load() - base;
+    }
+    state.counters["peak"] = double(peak);
+    state.counters["bytes"] = double(bytes);
+    state.counters["ratio"] = double(peak) / double(text.size());
+    if (used != 0u) {
+        state.counters["used"] = double(used);
+    }
+}
+
+#define BENCHMARK_FILES(name, json)                                                                \
+    BENCHMARK(name<json, canada>)->Iterations(iterations);                                         \
+    BENCHMARK(name<json, citm_catalog>)->Iterations(iterations);                                   \
+    BENCHMARK(name<json, twitter>)->Iterations(iterations);
+
+#ifdef HAS_NLOHMANN_JSON
+#define BENCHMARK_JSONS(name)                                                                      \
+    BENCHMARK_FILES(name, json_t)                                                                  \
+    BENCHMARK_FILES(name, json_view_t)                                                             \
+    BENCHMARK_FILES(name, json_pool_t)                                                             \
+    BENCHMARK_FILES(name, json_view_pool_t)                                                        \
+    BENCHMARK_FILES(name, nlohmann::json)
+#else
+#define BENCHMARK_JSONS(name)                                                                      \
+    BENCHMARK_FILES(name, json_t)                                                                  \
+    BENCHMARK_FILES(name, json_view_t)                                                             \
+    BENCHMARK_FILES(name, json_pool_t)                                                             \
+    BENCHMARK_FILES(name, json_view_pool_t)
+#endif
+
+/* 未指定 --benchmark_out 时同时把结果以 JSON 写入 benchmark_json.json, 便于版本间对比 */
+int32_t main(int32_t argc, char* argv[]) {
+    int32_t result{0};
+
+    do {
+        auto iterations = 100u;
+        std::vector<char*> args(argv, argv + argc);
+
+        if (argc > 1 && argv[1][0] != '-') {
+            auto [ptr, ec] = std::from_chars(argv[1], argv[1] + len(argv[1]), iterations);
+            if (ec != std::errc{}) {
+                result = -1;
+                break;
+            }
+            args.erase(args.begin() + 1);
+        }
+
+        auto has_out = std::any_of(args.begin(), args.end(), [](char* arg) {
+            return std::string(arg).rfind("--benchmark_out=", 0) == 0;
+        });
+        char out[] = "--benchmark_out=benchmark_json.json";
+        char out_format[] = "--benchmark_out_format=json";
+        if (!has_out) {
+            args.push_back(out);
+            args.push_back(out_format);
+        }
+        args.push_back(nullptr);
+        argc = int32_t(args.size() - 1);
+        argv = args.data();
+
+        benchmark::Initialize(&argc, argv);
+        benchmark::ReportUnrecognizedArguments(argc, argv);
+
+        BENCHMARK_JSONS(benchmark_parse)
+        BENCHMARK_JSONS(benchmark_traverse)
+        BENCHMARK_JSONS(benchmark_lookup)
+        BENCHMARK_JSONS(benchmark_to)
+        BENCHMARK_JSONS(benchmark_round_trip)
+        BENCHMARK_JSONS(benchmark_memory)
+
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+    } while (false);
+
+    return result;
+}
@@ -1,7 +1,7 @@
 #include <fstream>
 #include <iostream>
-#include <string>
 
+#include "qlib/file.h"
 #include "qlib/json.h"
 #include "qlib/string.h"
 
@@ -15,13 +15,18 @@ int32_t main(int32_t argc, char* argv[]) {
             break;
         }
 
-        std::ifstream ifs(argv[1]);
-        std::string text{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
-
         using namespace qlib;
 
+        mapped_file file;
+        if (0 != file.open(argv[1])) {
+            std::cerr << "Failed to open " << argv[1] << std::endl;
+            result = -3;
+            break;
+        }
+
+        /* json 直接引用映射内存, 不再复制文件内容 */
         json_view_t json;
-        result = json::parse(&json, text.data(), text.data() + text.size());
+        result = json::parse(&json, file);
         if (0 != result) {
             std::cout << "json::parse return " << result << std::endl;
             break;
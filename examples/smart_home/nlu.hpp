@@ -17,6 +17,52 @@
 
 namespace qlib {
 
+struct nlu_command {
+    string_view_t location;
+    string_view_t device;
+    string_view_t action;
+};
+
+struct nlu_rule {
+    string_view_t name;
+    string_view_t pattern;
+    vector_t<nlu_command> commands;
+};
+
+struct nlu_rules {
+    vector_t<nlu_rule> rules{64u};
+};
+
+namespace json {
+template <>
+struct binding<nlu_command> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("location", value.location);
+        func("device", value.device);
+        func("action", value.action);
+    }
+};
+
+template <>
+struct binding<nlu_rule> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("name", value.name);
+        func("pattern", value.pattern);
+        func("commands", value.commands);
+    }
+};
+
+template <>
+struct binding<nlu_rules> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("rules", value.rules);
+    }
+};
+};  // namespace json
+
 template <class _DataManager>
 class nlu : public object {
 public:
@@ -34,18 +80,6 @@ public:
     };
 
 protected:
-    struct command {
-        string_view_t location;
-        string_view_t device;
-        string_view_t action;
-    };
-
-    struct rule {
-        string_view_t name;
-        string_view_t pattern;
-        vector_t<command> commands;
-    };
-
     slogger& _logger;
     bool_t _init{False};
     bool_t _exit{False};
@@ -55,7 +89,7 @@ protected:
     unique_ptr_t<publisher_type> _publisher_command;
     std::shared_ptr<string_t> _text;
     string_t _rules_text;
-    vector_t<rule> _rules;
+    nlu_rules _rules;
 
     string_t _file_(string_view_t __file) const {
         string_t __f{__file.begin(), __file.end()};
@@ -104,31 +138,13 @@ protected:
                 break;
             }
             _rules_text = string::from_file(rules_path);
-            json_view_t json;
-            result = json::parse(&json, _rules_text.begin(), _rules_text.end());
-            if (0 != result) {
-                _logger.error("nlu: json::parse return {}!", result);
+            /* string_view_t 成员直接引用 _rules_text */
+            if (json::decode(&_rules, _rules_text.begin(), _rules_text.end()) != 0) {
+                _logger.error("nlu: rules is not a valid json object!");
                 result = rules_load_error;
                 break;
             }
-            _logger.debug("nlu::rules: {}", string::from_json(json, _rules_text.size()));
-
-            _rules.reserve(64u);
-            for (auto& r : json["rules"].array()) {
-                vector_t<command> commands;
-                for (auto& c : r["commands"].array()) {
-                    commands.emplace_back(command{
-                        .location = c["location"].get<string_view_t>(),
-                        .device = c["device"].get<string_view_t>(),
-                        .action = c["action"].get<string_view_t>(),
-                    });
-                }
-                _rules.emplace_back(rule{
-                    .name = r["name"].get<string_view_t>(),
-                    .pattern = r["pattern"].get<string_view_t>(),
-                    .commands = qlib::move(commands),
-                });
-            }
+            _logger.debug("nlu::rules: {}", _rules_text);
 
             _init = True;
             _logger.trace("nlu: init!");
@@ -162,7 +178,7 @@ protected:
                 _logger.debug("nlu: parse enter:");
                 _logger.debug("nlu: text: {}", *text);
 
-                for (auto& r : _rules) {
+                for (auto& r : _rules.rules) {
                     std::regex pattern(std::string{r.pattern.begin(), r.pattern.end()});
                     std::smatch match;
                     std::string input_str{text->begin(), text->end()};
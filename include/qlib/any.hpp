@@ -112,11 +112,11 @@ protected:
     }
 
 public:
-    ALWAYS_INLINE CONSTEXPR value() { new (&_storage) manager(); }
-    ALWAYS_INLINE CONSTEXPR value(self const& __a) { __a._manager_()->construct(_manager_()); }
-    ALWAYS_INLINE CONSTEXPR value(self&& __a) { __a._manager_()->move_construct(_manager_()); }
+    ALWAYS_INLINE value() { new (&_storage) manager(); }
+    ALWAYS_INLINE value(self const& __a) { __a._manager_()->construct(_manager_()); }
+    ALWAYS_INLINE value(self&& __a) { __a._manager_()->move_construct(_manager_()); }
 
-    ALWAYS_INLINE CONSTEXPR value(nullptr_t) : value() {}
+    ALWAYS_INLINE value(nullptr_t) : value() {}
 
     template <class _Tp, class Enable = enable_if_t<!is_same_v<remove_cvref_t<_Tp>, self>>>
     ALWAYS_INLINE CONSTEXPR value(_Tp&& value) {
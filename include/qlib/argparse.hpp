@@ -63,33 +63,10 @@ template <class _Tp>
 class converter<_Tp, enable_if_t<is_floating_point_v<_Tp>>> : public object {
 public:
     template <class Iter1, class Iter2>
-    NODISCARD ALWAYS_INLINE CONSTEXPR static auto decode(Iter1 first, Iter2 last) {
+    NODISCARD ALWAYS_INLINE static auto decode(Iter1 first, Iter2 last) {
         _Tp _value{0u};
-
-        _Tp sign = 1;
-        if (*first == '-') {
-            sign = -1;
-            ++first;
-        }
-
-        while (first < last && is_digit(*first)) {
-            _value = _value * 10u + static_cast<_Tp>(*first - '0');
-            ++first;
-        }
-
-        if (*first == '.') {
-            ++first;
-            _Tp base = 0.1;
-            while (first < last && is_digit(*first)) {
-                _value += static_cast<_Tp>(*first - '0') * base;
-                base *= 0.1;
-                ++first;
-            }
-        }
-
-        throw_if(first != last, "not floating point");
-
-        return sign * _value;
+        throw_if(string::from_chars(first, last, _value) != last, "not floating point");
+        return _value;
     }
 };
 
@@ -0,0 +1 @@
+#include "qlib/cbor.hpp"
@@ -0,0 +1,449 @@
+#ifndef QLIB_CBOR_HPP
+#define QLIB_CBOR_HPP
+
+#include "qlib/json.h"
+
+namespace qlib {
+
+namespace cbor {
+
+using error = json::error;
+
+/* CBOR (RFC 8949) 与 json::value 互转, 字符串的保存方式与 msgpack 相同.
+ * 字节串解码为 value_enum::binary, 不定长的字节串与文本串拼接后保存; tag 被忽略, 只保留其内容;
+ * undefined 视为 null, NaN 与 Inf 转为 null; 其余简单值与非文本串的键返回 invalid_binary */
+template <class Json>
+class parser final : public object {
+public:
+    using self = parser;
+    using json_type = Json;
+    using char_type = typename json_type::char_type;
+    using allocator_type = typename json_type::allocator_type;
+    using array_type = typename json_type::array_type;
+    using object_type = typename json_type::object_type;
+    using string_view_t = string::view<char_type>;
+    using string_t = string::value<char_type>;
+    constexpr static uint32_t max_depth = 1024u;
+
+    static_assert(sizeof(char_type) == 1u, "cbor only supports 8-bit characters");
+
+protected:
+    uint8_t const* _cur;
+    uint8_t const* _end;
+    allocator_type& _allocator;
+    uint32_t _depth{0u};
+    string_t _buffer{};
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE bool_t _read(T& value) noexcept {
+        if (unlikely(size_t(_end - _cur) < sizeof(T))) {
+            return False;
+        }
+        value = memory::load_big_endian<T>(_cur);
+        _cur += sizeof(T);
+        return True;
+    }
+
+    /* 头部的附加信息: 0-23 为值本身, 24-27 后跟 1, 2, 4, 8 字节 */
+    NODISCARD ALWAYS_INLINE bool_t _argument(uint8_t info, uint64_t& value) noexcept {
+        switch (info) {
+            case 24u: {
+                uint8_t n;
+                return _read(n) ? (value = n, True) : False;
+            }
+            case 25u: {
+                uint16_t n;
+                return _read(n) ? (value = n, True) : False;
+            }
+            case 26u: {
+                uint32_t n;
+                return _read(n) ? (value = n, True) : False;
+            }
+            case 27u:
+                return _read(value);
+            default:
+                value = info;
+                return info < 24u;
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t _bytes(string_view_t& value, uint64_t size) noexcept {
+        if (unlikely(size_t(_end - _cur) < size)) {
+            return False;
+        }
+        value = string_view_t((char_type const*)(_cur), (char_type const*)(_cur + size));
+        _cur += size;
+        return True;
+    }
+
+    /* 拼接结果在 _buffer 中; view 策略的节点需要引用它, 因此复制到 allocator */
+    template <class T = typename json_type::string_type>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_view_t>, string_view_t> _own(
+        string_view_t text) {
+        static_assert(!is_same_v<allocator_type, new_allocator_t>,
+                      "view policy needs an arena allocator (pool_allocator_t) to hold chunks");
+        auto impl = _allocator.template allocate<char_type>(text.size());
+        qlib::copy(text.begin(), text.end(), impl);
+        return string_view_t(impl, impl + text.size());
+    }
+
+    template <class T = typename json_type::string_type>
+    NODISCARD ALWAYS_INLINE enable_if_t<!is_same_v<T, string_view_t>, string_view_t> _own(
+        string_view_t text) noexcept {
+        return text;
+    }
+
+    /* 读取主类型为 major 的字节串或文本串, info 为 31 时是以 0xFF 结束的若干定长分块 */
+    NODISCARD int32_t _chunks(uint8_t major, uint8_t info, string_view_t& text) {
+        uint64_t size;
+        if (info != 31u) {
+            return _argument(info, size) && _bytes(text, size) ? 0 : int32_t(error::invalid_binary);
+        }
+        _buffer.clear();
+        while (True) {
+            if (unlikely(_cur == _end)) {
+                return int32_t(error::invalid_binary);
+            }
+            auto c = *_cur++;
+            if (c == 0xFFu) {
+                break;
+            }
+            string_view_t chunk;
+            if (unlikely((c >> 5) != major || !_argument(c & 0x1Fu, size) ||
+                         !_bytes(chunk, size))) {
+                return int32_t(error::invalid_binary);
+            }
+            /* 空的分块合法, _buffer 可能还没有分配存储 */
+            if (size != 0u) {
+                _buffer << chunk;
+            }
+        }
+        text = _buffer.empty() ? string_view_t()
+                               : _own(string_view_t(_buffer.begin(), _buffer.end()));
+        return 0;
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE int32_t _number(json_type& value, T number) {
+        if (is_floating_point_v<T> && (_isnan_(float64_t(number)) || _isinf_(float64_t(number)))) {
+            value = json_type(_allocator);
+        } else {
+            value = json_type(number, _allocator);
+        }
+        return 0;
+    }
+
+    /* IEEE 754 半精度, 指数全 1 时为 NaN 或 Inf */
+    NODISCARD ALWAYS_INLINE int32_t _half(json_type& value, uint16_t bits) {
+        auto exponent = int32_t((bits >> 10) & 0x1Fu);
+        auto mantissa = float64_t(bits & 0x3FFu);
+        if (exponent == 0x1F) {
+            value = json_type(_allocator);
+            return 0;
+        }
+        float64_t number = exponent == 0 ? mantissa / 16777216.0 : (mantissa + 1024.0);
+        for (; exponent > 25; --exponent) {
+            number *= 2.0;
+        }
+        for (; exponent != 0 && exponent < 25; ++exponent) {
+            number *= 0.5;
+        }
+        return _number(value, (bits & 0x8000u) ? -number : number);
+    }
+
+    NODISCARD int32_t _array(json_type& value, uint8_t info) {
+        uint64_t size{0u};
+        bool_t indefinite = info == 31u;
+        if (unlikely(!indefinite && (!_argument(info, size) || size > size_t(_end - _cur)))) {
+            return int32_t(error::invalid_binary);
+        }
+        value = json_type(array_type(indefinite ? 16u : size_t(size), _allocator), _allocator);
+        auto& array = value.array();
+        for (uint64_t i = 0u; indefinite || i < size; ++i) {
+            if (indefinite && _cur < _end && *_cur == 0xFFu) {
+                ++_cur;
+                break;
+            }
+            array.emplace_back(_allocator);
+            int32_t result = _value(array.back());
+            if (unlikely(result != 0)) {
+                return result;
+            }
+        }
+        return 0;
+    }
+
+    NODISCARD int32_t _object(json_type& value, uint8_t info) {
+        uint64_t size{0u};
+        bool_t indefinite = info == 31u;
+        if (unlikely(!indefinite && (!_argument(info, size) || size > size_t(_end - _cur) / 2u))) {
+            return int32_t(error::invalid_binary);
+        }
+        value = json_type(object_type(indefinite ? 16u : size_t(size), _allocator), _allocator);
+        auto& object = value.object();
+        for (uint64_t i = 0u; indefinite || i < size; ++i) {
+            if (unlikely(_cur == _end)) {
+                return int32_t(error::invalid_binary);
+            }
+            auto c = *_cur++;
+            if (indefinite && c == 0xFFu) {
+                break;
+            }
+            string_view_t key;
+            if (unlikely((c >> 5) != 3u)) {
+                return int32_t(error::invalid_binary);
+            }
+            int32_t result = _chunks(3u, c & 0x1Fu, key);
+            if (unlikely(result != 0)) {
+                return result;
+            }
+            object.emplace_back(json::make_key<json_type>(key, _allocator), json_type(_allocator));
+            result = _value(object.back().value);
+            if (unlikely(result != 0)) {
+                return result;
+            }
+        }
+        return 0;
+    }
+
+    NODISCARD int32_t _simple(json_type& value, uint8_t info) {
+        switch (info) {
+            case 20u:
+            case 21u: {
+                value = json_type(bool_t(info == 21u), _allocator);
+                return 0;
+            }
+            case 22u:
+            case 23u: {
+                value = json_type(_allocator);
+                return 0;
+            }
+            case 25u: {
+                uint16_t bits;
+                return _read(bits) ? _half(value, bits) : int32_t(error::invalid_binary);
+            }
+            case 26u: {
+                uint32_t bits;
+                if (unlikely(!_read(bits))) {
+                    return int32_t(error::invalid_binary);
+                }
+                float32_t f;
+                _memcpy_(&f, &bits, sizeof(f));
+                return _number(value, float64_t(f));
+            }
+            case 27u: {
+                uint64_t bits;
+                if (unlikely(!_read(bits))) {
+                    return int32_t(error::invalid_binary);
+                }
+                float64_t f;
+                _memcpy_(&f, &bits, sizeof(f));
+                return _number(value, f);
+            }
+            default:
+                /* 其余简单值与位置错误的 break */
+                return int32_t(error::invalid_binary);
+        }
+    }
+
+    NODISCARD int32_t _value(json_type& value) {
+        if (unlikely(_cur == _end || _depth >= max_depth)) {
+            return int32_t(error::invalid_binary);
+        }
+        auto c = *_cur++;
+        uint8_t info = c & 0x1Fu;
+        uint64_t number;
+        switch (c >> 5) {
+            case 0u:
+                return _argument(info, number) ? _number(value, number)
+                                               : int32_t(error::invalid_binary);
+            case 1u: {
+                if (unlikely(!_argument(info, number))) {
+                    return int32_t(error::invalid_binary);
+                }
+                /* -1 - n 超出 int64_t 时只能近似为浮点数 */
+                if (number > 0x7FFFFFFFFFFFFFFFull) {
+                    return _number(value, -1.0 - float64_t(number));
+                }
+                return _number(value, -1 - int64_t(number));
+            }
+            case 2u:
+            case 3u: {
+                string_view_t text;
+                int32_t result = _chunks(c >> 5, info, text);
+                if (likely(result == 0)) {
+                    value = (c >> 5) == 2u ? json_type::binary(text, _allocator)
+                                           : json::make_string<json_type>(text, _allocator);
+                }
+                return result;
+            }
+            case 4u:
+            case 5u: {
+                ++_depth;
+                int32_t result = (c >> 5) == 4u ? _array(value, info) : _object(value, info);
+                --_depth;
+                return result;
+            }
+            case 6u: {
+                if (unlikely(!_argument(info, number))) {
+                    return int32_t(error::invalid_binary);
+                }
+                ++_depth;
+                int32_t result = _value(value);
+                --_depth;
+                return result;
+            }
+            default:
+                return _simple(value, info);
+        }
+    }
+
+public:
+    ALWAYS_INLINE parser(uint8_t const* begin, uint8_t const* end, allocator_type& allocator) noexcept
+            : _cur(begin), _end(end), _allocator(allocator) {}
+
+    /* 输入必须恰好是一个值 */
+    NODISCARD ALWAYS_INLINE int32_t operator()(json_type* json) {
+        int32_t result = _value(*json);
+        if (result == 0 && _cur != _end) {
+            result = int32_t(error::invalid_binary);
+        }
+        if (result != 0) {
+            *json = json_type(_allocator);
+        }
+        return result;
+    }
+};
+
+template <class Json, class Iter1, class Iter2>
+ALWAYS_INLINE int32_t parse(Json* json, Iter1 begin, Iter2 end) {
+    auto first = (uint8_t const*)(&*begin);
+    return parser<Json>(first, first + (end - begin), json->allocator())(json);
+}
+
+/* 头部总是使用最短编码, 浮点数总是 8 字节 */
+template <class OutStream>
+class encoder final : public object {
+public:
+    using self = encoder;
+    using string_view_t = string::view<char>;
+
+protected:
+    OutStream& _out;
+
+    ALWAYS_INLINE void _write(uint8_t const* data, size_t size) {
+        _out << string_view_t((char const*)(data), (char const*)(data + size));
+    }
+
+    template <class T>
+    ALWAYS_INLINE void _put(uint8_t c, T value) {
+        uint8_t s[1u + sizeof(T)];
+        s[0] = c;
+        memory::store_big_endian(s + 1, value);
+        _write(s, sizeof(s));
+    }
+
+    ALWAYS_INLINE void _byte(uint8_t c) { _write(&c, 1u); }
+
+    ALWAYS_INLINE void _head(uint8_t major, uint64_t value) {
+        major <<= 5;
+        if (value < 24u) {
+            _byte(uint8_t(major | value));
+        } else if (value <= 0xFFu) {
+            _put(uint8_t(major | 24u), uint8_t(value));
+        } else if (value <= 0xFFFFu) {
+            _put(uint8_t(major | 25u), uint16_t(value));
+        } else if (value <= 0xFFFFFFFFu) {
+            _put(uint8_t(major | 26u), uint32_t(value));
+        } else {
+            _put(uint8_t(major | 27u), value);
+        }
+    }
+
+    ALWAYS_INLINE void _number(uint64_t value) { _head(0u, value); }
+
+    ALWAYS_INLINE void _number(int64_t value) {
+        if (value >= 0) {
+            _head(0u, uint64_t(value));
+        } else {
+            _head(1u, uint64_t(-1 - value));
+        }
+    }
+
+    ALWAYS_INLINE void _number(float64_t value) {
+        uint64_t bits;
+        _memcpy_(&bits, &value, sizeof(bits));
+        _put(uint8_t(0xFBu), bits);
+    }
+
+    ALWAYS_INLINE void _string(string_view_t text) {
+        json::unescape(text, [this](string_view_t s) {
+            _head(3u, uint64_t(s.size()));
+            _out << s;
+        });
+    }
+
+public:
+    ALWAYS_INLINE explicit encoder(OutStream& out) noexcept : _out(out) {}
+
+    template <class Json>
+    void operator()(Json const& node) {
+        switch (node.type()) {
+            case json::value_enum::null: {
+                _byte(0xF6u);
+                break;
+            }
+            case json::value_enum::boolean: {
+                _byte(node.template get<bool_t>() ? 0xF5u : 0xF4u);
+                break;
+            }
+            case json::value_enum::number:
+            case json::value_enum::number_ref: {
+                node.visit_number([this](auto value) { _number(value); });
+                break;
+            }
+            case json::value_enum::string: {
+                _string(node.template get<string_view_t>());
+                break;
+            }
+            case json::value_enum::binary: {
+                auto bytes = node.binary();
+                _head(2u, uint64_t(bytes.size()));
+                _out << bytes;
+                break;
+            }
+            case json::value_enum::array: {
+                auto& array = node.array();
+                _head(4u, uint64_t(array.size()));
+                for (auto& item : array) {
+                    (*this)(item);
+                }
+                break;
+            }
+            case json::value_enum::object: {
+                auto& object = node.object();
+                _head(5u, uint64_t(object.size()));
+                for (auto& item : object) {
+                    _string(string_view_t(item.key.begin(), item.key.end()));
+                    (*this)(item.value);
+                }
+                break;
+            }
+        }
+    }
+};
+
+/* 输出端与 json::value::to 相同, 只需支持 << string_view_t */
+template <class Json, class OutStream>
+ALWAYS_INLINE OutStream& to(Json const& json, OutStream& out) {
+    static_assert(sizeof(typename Json::char_type) == 1u, "cbor only supports 8-bit characters");
+    encoder<OutStream> encoder(out);
+    encoder(json);
+    return out;
+}
+
+};  // namespace cbor
+
+};  // namespace qlib
+
+#endif
@@ -0,0 +1 @@
+#include "qlib/file.hpp"
\ No newline at end of file
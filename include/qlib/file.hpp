@@ -0,0 +1,188 @@
+#ifndef QLIB_FILE_HPP
+#define QLIB_FILE_HPP
+
+#if defined(_WIN32)
+#include <stdio.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "qlib/memory.h"
+#include "qlib/string.h"
+
+namespace qlib {
+
+/* 只读映射整个文件, 末尾保证至少 padding 个可读的 0 字节, SIMD 扫描可越界读取.
+ * view 策略解析出的文档直接引用映射内存, 生命周期不能超过 mapped_file */
+class mapped_file final : public object {
+public:
+    using self = mapped_file;
+    using char_type = char;
+    using size_type = size_t;
+    using string_view_t = string::view<char>;
+    constexpr static size_type padding = 64u;
+
+protected:
+    char* _data{nullptr};
+    size_type _size{0u};
+    size_type _mapped{0u};
+
+#if defined(_WIN32)
+    int32_t _open(char const* path) noexcept {
+        auto file = fopen(path, "rb");
+        if (file == nullptr) {
+            return -1;
+        }
+        int32_t result{0};
+        do {
+            if (fseek(file, 0, SEEK_END) != 0) {
+                result = -1;
+                break;
+            }
+            auto size = ftell(file);
+            if (size < 0 || fseek(file, 0, SEEK_SET) != 0) {
+                result = -1;
+                break;
+            }
+            _mapped = size_type(size) + padding;
+            _data = new_allocator_t::allocate<char>(_mapped);
+            _memset_(_data + size, 0, padding);
+            if (fread(_data, 1u, size_type(size), file) != size_type(size)) {
+                new_allocator_t::deallocate<char>(_data, _mapped);
+                _data = nullptr;
+                _mapped = 0u;
+                result = -1;
+                break;
+            }
+            _size = size_type(size);
+        } while (false);
+        fclose(file);
+        return result;
+    }
+
+    ALWAYS_INLINE void _close() noexcept { new_allocator_t::deallocate<char>(_data, _mapped); }
+#else
+    int32_t _open(char const* path) noexcept {
+        auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return -1;
+        }
+        int32_t result{0};
+        do {
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                result = -1;
+                break;
+            }
+            auto size = size_type(st.st_size);
+            if (size == 0u) {
+                break;
+            }
+
+            /* 最后一页的剩余空间不足 padding 时, 先保留一段匿名的 0 页, 再把文件固定映射到开头 */
+            auto page = size_type(sysconf(_SC_PAGESIZE));
+            auto mapped = memory::align_up(size, page);
+            void* base{nullptr};
+            if (mapped - size >= padding) {
+                base = mmap(nullptr, mapped, PROT_READ, MAP_PRIVATE, fd, 0);
+            } else {
+                mapped = memory::align_up(size + padding, page);
+                base = mmap(nullptr, mapped, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (base != MAP_FAILED &&
+                    mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                    munmap(base, mapped);
+                    base = MAP_FAILED;
+                }
+            }
+            if (base == MAP_FAILED) {
+                result = -1;
+                break;
+            }
+#if defined(MADV_SEQUENTIAL) && defined(MADV_WILLNEED)
+            madvise(base, size, MADV_SEQUENTIAL);
+            madvise(base, size, MADV_WILLNEED);
+#endif
+            _data = (char*)(base);
+            _size = size;
+            _mapped = mapped;
+        } while (false);
+        ::close(fd);
+        return result;
+    }
+
+    ALWAYS_INLINE void _close() noexcept { munmap(_data, _mapped); }
+#endif
+
+public:
+    mapped_file(self const&) = delete;
+    self& operator=(self const&) = delete;
+
+    ALWAYS_INLINE mapped_file() = default;
+
+    ALWAYS_INLINE explicit mapped_file(char const* path) {
+        throw_if(open(path) != 0, "open failed");
+    }
+
+    template <class Allocator>
+    ALWAYS_INLINE explicit mapped_file(string::value<char, Allocator> const& path)
+            : mapped_file(path.c_str()) {}
+
+    ALWAYS_INLINE mapped_file(self&& o) noexcept
+            : _data(o._data), _size(o._size), _mapped(o._mapped) {
+        o._data = nullptr;
+        o._size = 0u;
+        o._mapped = 0u;
+    }
+
+    ALWAYS_INLINE self& operator=(self&& o) noexcept {
+        if (likely(this != &o)) {
+            close();
+            _data = o._data;
+            _size = o._size;
+            _mapped = o._mapped;
+            o._data = nullptr;
+            o._size = 0u;
+            o._mapped = 0u;
+        }
+        return *this;
+    }
+
+    ALWAYS_INLINE ~mapped_file() noexcept { close(); }
+
+    /* 成功返回 0; 空文件也视为成功 */
+    ALWAYS_INLINE int32_t open(char const* path) noexcept {
+        close();
+        return _open(path);
+    }
+
+    ALWAYS_INLINE void close() noexcept {
+        if (_data != nullptr) {
+            _close();
+        }
+        _data = nullptr;
+        _size = 0u;
+        _mapped = 0u;
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t is_open() const noexcept { return _data != nullptr; }
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return _size == 0u; }
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept { return _size; }
+
+    /* 空文件返回指向静态空串的指针, 解析函数无需特判 */
+    NODISCARD ALWAYS_INLINE char const* data() const noexcept {
+        return _data != nullptr ? _data : "";
+    }
+
+    NODISCARD ALWAYS_INLINE char const* begin() const noexcept { return data(); }
+    NODISCARD ALWAYS_INLINE char const* end() const noexcept { return data() + _size; }
+    NODISCARD ALWAYS_INLINE string_view_t view() const noexcept {
+        return string_view_t(begin(), end());
+    }
+};
+
+};  // namespace qlib
+
+#endif
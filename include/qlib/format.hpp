@@ -224,15 +224,43 @@ struct formatter<_Tp, _Char, enable_if_t<is_signed_v<_Tp>>> final : public objec
 
 template <class _Tp, class _Char>
 struct formatter<_Tp, _Char, enable_if_t<is_floating_point_v<_Tp>>> final : public object {
+    /* [.precision][e|f|g], 缺省为最短可往返表示 */
     struct specs {
-        size_t precision{6u};
+        string::chars_format format{string::chars_format::general};
+        size_t precision{0u};
+        bool_t shortest{True};
+        bool_t plain{True};
         ALWAYS_INLINE CONSTEXPR specs(string::view<_Char> fmt) {
-            if (fmt.size() > 3) {
-                throw_if(fmt[0] != '.', "missing '.'");
-                throw_if(fmt[1] < '0' || fmt[1] > '9', "invalid number");
-                throw_if(fmt[2] != 'f', "missing 'f'");
-                precision = fmt[1] - '0';
+            auto it = fmt.begin();
+            if (it != fmt.end() && *it == '.') {
+                ++it;
+                throw_if(it == fmt.end() || !is_digit(*it), "invalid number");
+                while (it != fmt.end() && is_digit(*it)) {
+                    precision = precision * 10u + size_t(*it - '0');
+                    throw_if(precision > 99u, "invalid precision");
+                    ++it;
+                }
+                shortest = False;
+                plain = False;
+            }
+            if (it != fmt.end()) {
+                switch (*it) {
+                    case 'e':
+                        format = string::chars_format::scientific;
+                        break;
+                    case 'f':
+                        format = string::chars_format::fixed;
+                        break;
+                    case 'g':
+                        format = string::chars_format::general;
+                        break;
+                    default:
+                        throw_if(True, "invalid type");
+                }
+                plain = False;
+                ++it;
             }
+            throw_if(it != fmt.end(), "invalid format");
         }
     };
 
@@ -245,11 +273,17 @@ struct formatter<_Tp, _Char, enable_if_t<is_floating_point_v<_Tp>>> final : publ
             auto str = string::inf_str<_Char>;
             out.emplace(str.begin(), str.end());
         } else {
-            formatter<int64_t, _Char> f;
-            f(out, int64_t(value), string::view<_Char>{});
-            char str[16u]{'\0'};
-            string::__to_chars_for_frac(str, value - int64_t(value), specs.precision);
-            out.emplace(str, str + specs.precision + 1u);
+            char str[512u];
+            char* last;
+            if (specs.plain) {
+                last = string::to_chars(str, str + sizeof(str), value);
+            } else if (specs.shortest) {
+                last = string::to_chars(str, str + sizeof(str), value, specs.format);
+            } else {
+                last = string::to_chars(str, str + sizeof(str), value, specs.format,
+                                        specs.precision);
+            }
+            out.emplace(str, last);
         }
     }
 };
@@ -6,6 +6,10 @@
 #include "qlib/string.h"
 #include "qlib/vector.h"
 
+#if defined(__AVX2__) || defined(__SSE4_2__) || defined(__SSE2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#endif
+
 namespace qlib {
 
 namespace json {
@@ -19,6 +23,16 @@ enum : size_t {
 template <class T>
 constexpr static bool_t is_number_v = is_signed_v<T> || is_unsigned_v<T> || is_floating_point_v<T>;
 
+using parse_option = uint32_t;
+enum : uint32_t {
+    parse_default = 0u,
+    parse_two_stage = 1u << 0,
+    parse_hash_index = 1u << 1,
+    parse_number_cache = 1u << 2,
+    parse_exact_capacity = 1u << 3,
+    parse_validate_utf8 = 1u << 4,
+};
+
 enum class error : int32_t {
     unknown = -1,
     impl_nullptr = -2,
@@ -35,6 +49,16 @@ enum class error : int32_t {
     invalid_unicode = -13,
     invalid_null = -14,
     invalid_boolean = -15,
+    invalid_utf8 = -16,
+    invalid_binary = -17,
+    depth_exceeded = -18,
+    invalid_patch = -19,
+    path_not_found = -20,
+    test_failed = -21,
+    trailing_characters = -22,
+    invalid_number = -23,
+    control_character = -24,
+    invalid_escape = -25,
 };
 
 enum class value_enum : uint8_t {
@@ -44,10 +68,18 @@ enum class value_enum : uint8_t {
     string = 1 << 2,
     number = 1 << 3,
     boolean = 1 << 4,
-    // string_ref = 1 << 5,
+    binary = 1 << 5,
     number_ref = 1 << 6,
 };
 
+/* number/number_ref 已解码数值的类型 */
+enum class number_enum : uint8_t {
+    none = 0,
+    int64,
+    uint64,
+    float64,
+};
+
 template <class T, class Iter1, class Iter2>
 ALWAYS_INLINE CONSTEXPR auto exp(T& value, Iter1& first, Iter2 last) {
     if (*first == 'e' || *first == 'E') {
@@ -123,35 +155,8 @@ template <class T>
 class converter<T, enable_if_t<is_floating_point_v<T>>> : public object {
 public:
     template <class Iter1, class Iter2>
-    ALWAYS_INLINE CONSTEXPR static auto decode(T& value, Iter1 first, Iter2 last) {
-        T _value{0u};
-
-        T sign = 1;
-        if (*first == '-') {
-            sign = -1;
-            ++first;
-        }
-
-        while (first < last && is_digit(*first)) {
-            _value = _value * 10u + static_cast<T>(*first - '0');
-            ++first;
-        }
-
-        if (*first == '.') {
-            ++first;
-            T base = 0.1;
-            while (first < last && is_digit(*first)) {
-                _value += static_cast<T>(*first - '0') * base;
-                base *= 0.1;
-                ++first;
-            }
-        }
-
-        exp(_value, first, last);
-
-        throw_if(first != last, "not number");
-
-        value = sign * _value;
+    ALWAYS_INLINE static auto decode(T& value, Iter1 first, Iter2 last) {
+        throw_if(string::from_chars(first, last, value) != last, "not number");
     }
 };
 
@@ -189,9 +194,369 @@ struct storage final {
     };
 };
 
+/* 对象键的开放寻址哈希索引, 只记录键在 object_type 中的下标, 插入顺序与存储不变 */
+template <class Char, class Allocator>
+class hash_index final : public object {
+public:
+    using self = hash_index;
+    using size_type = uint32_t;
+    using string_view_t = string::view<Char>;
+    static constexpr size_type npos = size_type(-1);
+
+protected:
+    struct slot final {
+        uint32_t hash;
+        uint32_t pos;  // 下标 + 1, 0 表示空
+    };
+
+    vector_t<slot, Allocator> _slots;
+    size_type _size{0u};
+
+    template <class Key>
+    NODISCARD ALWAYS_INLINE static uint32_t _hash(Key const& key) noexcept {
+        return uint32_t(string::hash(string_view_t(key.begin(), key.end())));
+    }
+
+    ALWAYS_INLINE void _insert(uint32_t hash, size_type pos) noexcept {
+        size_type mask = _slots.size() - 1u;
+        size_type i = hash & mask;
+        while (_slots[i].pos != 0u) {
+            i = (i + 1u) & mask;
+        }
+        _slots[i].hash = hash;
+        _slots[i].pos = pos + 1u;
+    }
+
+public:
+    ALWAYS_INLINE hash_index() = default;
+    ALWAYS_INLINE explicit hash_index(Allocator& allocator) : _slots(allocator) {}
+
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept { return _size; }
+
+    /* 对象可能被任意修改, 下次 update 时整体重建 */
+    ALWAYS_INLINE void invalidate() noexcept { _size = npos; }
+
+    /* 只追加新增的键; 对象变小, 失效或装载率超过 1/2 时重建 */
+    template <class Object>
+    ALWAYS_INLINE void update(Object const& object) {
+        size_type size = object.size();
+        if (unlikely(size < _size || size * 2u > _slots.size())) {
+            size_type capacity{16u};
+            while (capacity < size * 2u) {
+                capacity <<= 1u;
+            }
+            _slots.resize(capacity);
+            _memset_(_slots.data(), 0, capacity * sizeof(slot));
+            _size = 0u;
+        }
+        for (auto i = _size; i < size; ++i) {
+            _insert(_hash(object[i].key), i);
+        }
+        _size = size;
+    }
+
+    template <class Object>
+    NODISCARD ALWAYS_INLINE size_type find(Object const& object, string_view_t key) const noexcept {
+        return find(object, key, _hash(key));
+    }
+
+    template <class Object>
+    NODISCARD ALWAYS_INLINE size_type find(Object const& object,
+                                           string_view_t key,
+                                           uint32_t hash) const noexcept {
+        size_type mask = _slots.size() - 1u;
+        for (size_type i = hash & mask; _slots[i].pos != 0u; i = (i + 1u) & mask) {
+            if (_slots[i].hash == hash && object[_slots[i].pos - 1u].key == key) {
+                return _slots[i].pos - 1u;
+            }
+        }
+        return npos;
+    }
+};
+
+/* 比较对象时记录已匹配的成员, 重复的键不能匹配到同一个成员, 保证比较是对称的 */
+class __member_marks final : public object {
+public:
+    using size_type = uint32_t;
+
+protected:
+    uint64_t _small{0u};
+    vector_t<uint64_t> _large;
+
+public:
+    ALWAYS_INLINE explicit __member_marks(size_type size) {
+        if (size > 64u) {
+            _large.resize((size + 63u) / 64u);
+            _memset_(_large.data(), 0, _large.size() * sizeof(uint64_t));
+        }
+    }
+
+    /* 已经标记过返回 False */
+    NODISCARD ALWAYS_INLINE bool_t mark(size_type pos) noexcept {
+        auto& word = _large.empty() ? _small : _large[pos / 64u];
+        auto bit = uint64_t(1u) << (pos % 64u);
+        if (word & bit) {
+            return False;
+        }
+        word |= bit;
+        return True;
+    }
+};
+
+namespace simd {
+
+/* 返回 [first, last) 中第一个 '\\' 的偏移, 字符串值内不含未转义的 '"' */
+NODISCARD ALWAYS_INLINE static size_t backslash_prefix(uint8_t const* first,
+                                                       uint8_t const* last) noexcept {
+    auto p = first;
+#if defined(__AVX2__)
+    auto const backslash32 = _mm256_set1_epi8('\\');
+    for (; p + 32 <= last; p += 32) {
+        auto chunk = _mm256_loadu_si256((__m256i const*)(p));
+        auto mask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash32)));
+        if (mask != 0u) {
+            return size_t(p - first) + __builtin_ctz(mask);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    auto const backslash16 = _mm_set1_epi8('\\');
+    for (; p + 16 <= last; p += 16) {
+        auto chunk = _mm_loadu_si128((__m128i const*)(p));
+        auto mask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash16)));
+        if (mask != 0u) {
+            return size_t(p - first) + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (p < last && *p != '\\') {
+        ++p;
+    }
+    return size_t(p - first);
+}
+
+/* 逐字符校验 UTF-8 (RFC 3629): 拒绝过长编码, 代理区与超过 U+10FFFF 的码点, 8 字节一组跳过 ASCII */
+NODISCARD inline bool_t validate_utf8_scalar(uint8_t const* p, uint8_t const* last) noexcept {
+    while (p < last) {
+        if (p + 8 <= last) {
+            uint64_t word;
+            _memcpy_(&word, p, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0u) {
+                p += 8;
+                continue;
+            }
+        }
+        auto c = *p;
+        if (c < 0x80u) {
+            ++p;
+            continue;
+        }
+        uint32_t size;
+        uint32_t code;
+        uint32_t min;
+        if ((c & 0xE0u) == 0xC0u) {
+            size = 2u, code = c & 0x1Fu, min = 0x80u;
+        } else if ((c & 0xF0u) == 0xE0u) {
+            size = 3u, code = c & 0x0Fu, min = 0x800u;
+        } else if ((c & 0xF8u) == 0xF0u) {
+            size = 4u, code = c & 0x07u, min = 0x10000u;
+        } else {
+            return False;
+        }
+        if (size_t(last - p) < size) {
+            return False;
+        }
+        for (uint32_t i = 1u; i < size; ++i) {
+            if ((p[i] & 0xC0u) != 0x80u) {
+                return False;
+            }
+            code = (code << 6) | (p[i] & 0x3Fu);
+        }
+        if (code < min || code > 0x10FFFFu || (code >= 0xD800u && code <= 0xDFFFu)) {
+            return False;
+        }
+        p += size;
+    }
+    return True;
+}
+
+#if defined(__AVX2__)
+/* Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte":
+ * 用前一字节的高低半字节与当前字节的高半字节三次查表, 结果按位与即得到错误位 */
+class utf8_checker final : public object {
+protected:
+    constexpr static uint8_t too_short = 1u << 0;
+    constexpr static uint8_t too_long = 1u << 1;
+    constexpr static uint8_t overlong_3 = 1u << 2;
+    constexpr static uint8_t too_large = 1u << 3;
+    constexpr static uint8_t surrogate = 1u << 4;
+    constexpr static uint8_t overlong_2 = 1u << 5;
+    constexpr static uint8_t too_large_1000 = 1u << 6;
+    constexpr static uint8_t overlong_4 = 1u << 6;
+    constexpr static uint8_t two_conts = 1u << 7;
+    constexpr static uint8_t carry = too_short | too_long | two_conts;
+
+    __m256i _error{_mm256_setzero_si256()};
+    __m256i _prev{_mm256_setzero_si256()};
+    __m256i _prev_incomplete{_mm256_setzero_si256()};
+
+    NODISCARD ALWAYS_INLINE static __m256i _lookup(__m256i index,
+                                                   uint8_t const (&table)[16]) noexcept {
+        auto row = _mm_loadu_si128((__m128i const*)(table));
+        return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(row), index);
+    }
+
+    NODISCARD ALWAYS_INLINE static __m256i _high_nibble(__m256i v) noexcept {
+        return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+    }
+
+    /* 把上一块的末尾 N 个字节移入当前块开头 */
+    template <int N>
+    NODISCARD ALWAYS_INLINE static __m256i _prev_bytes(__m256i input, __m256i prev) noexcept {
+        return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+    }
+
+    NODISCARD ALWAYS_INLINE static __m256i _special_cases(__m256i input, __m256i prev1) noexcept {
+        constexpr static uint8_t byte_1_high[16] = {
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+            two_conts, two_conts, two_conts, two_conts, too_short | overlong_2, too_short,
+            too_short | overlong_3 | surrogate,
+            too_short | too_large | too_large_1000 | overlong_4,
+        };
+        constexpr static uint8_t byte_1_low[16] = {
+            carry | overlong_3 | overlong_2 | overlong_4,
+            carry | overlong_2,
+            carry,
+            carry,
+            carry | too_large,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+        };
+        constexpr static uint8_t byte_2_high[16] = {
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_short, too_short, too_short, too_short,
+        };
+        auto low = _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F));
+        return _mm256_and_si256(
+            _mm256_and_si256(_lookup(_high_nibble(prev1), byte_1_high), _lookup(low, byte_1_low)),
+            _lookup(_high_nibble(input), byte_2_high));
+    }
+
+    /* 第三, 四字节必须是延续字节; 与 two_conts 位异或后, 多余或缺失的延续字节都会留下错误位 */
+    NODISCARD ALWAYS_INLINE static __m256i _multibyte_lengths(__m256i input,
+                                                              __m256i prev,
+                                                              __m256i special) noexcept {
+        auto prev2 = _prev_bytes<2>(input, prev);
+        auto prev3 = _prev_bytes<3>(input, prev);
+        auto third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+        auto fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+        auto must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(char(0x80)));
+        return _mm256_xor_si256(must23, special);
+    }
+
+    /* 块末尾尚未结束的多字节序列 */
+    NODISCARD ALWAYS_INLINE static __m256i _incomplete(__m256i input) noexcept {
+        auto max = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                    char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+        return _mm256_subs_epu8(input, max);
+    }
+
+public:
+    ALWAYS_INLINE void next(uint8_t const* block) noexcept {
+        auto input = _mm256_loadu_si256((__m256i const*)(block));
+        if (_mm256_movemask_epi8(input) == 0) {
+            _error = _mm256_or_si256(_error, _prev_incomplete);
+        } else {
+            auto prev1 = _prev_bytes<1>(input, _prev);
+            auto special = _special_cases(input, prev1);
+            _error = _mm256_or_si256(_error, _multibyte_lengths(input, _prev, special));
+            _prev_incomplete = _incomplete(input);
+        }
+        _prev = input;
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t finish() noexcept {
+        _error = _mm256_or_si256(_error, _prev_incomplete);
+        return _mm256_testz_si256(_error, _error) != 0;
+    }
+};
+#endif
+
+NODISCARD inline bool_t validate_utf8(uint8_t const* first, uint8_t const* last) noexcept {
+#if defined(__AVX2__)
+    utf8_checker checker;
+    auto p = first;
+    for (; p + 32 <= last; p += 32) {
+        checker.next(p);
+    }
+    if (p < last) {
+        alignas(32) uint8_t tail[32];
+        _memset_(tail, 0, sizeof(tail));
+        _memcpy_(tail, p, size_t(last - p));
+        checker.next(tail);
+    }
+    return checker.finish();
+#else
+    return validate_utf8_scalar(first, last);
+#endif
+}
+
+};  // namespace simd
+
+template <class Char>
+NODISCARD ALWAYS_INLINE enable_if_t<sizeof(Char) == 1u, size_t> __backslash_prefix(
+    Char const* first, Char const* last) noexcept {
+    return simd::backslash_prefix((uint8_t const*)(first), (uint8_t const*)(last));
+}
+
+template <class Char>
+NODISCARD ALWAYS_INLINE enable_if_t<sizeof(Char) != 1u, size_t> __backslash_prefix(
+    Char const* first, Char const* last) noexcept {
+    auto p = first;
+    while (p < last && *p != '\\') {
+        ++p;
+    }
+    return size_t(p - first);
+}
+
 template <class Json>
 class parser;
 
+template <class Json>
+class stream_parser;
+
+template <class Char>
+class document_view;
+
+template <class Char = char, class Allocator = pool_allocator_t>
+class compact;
+
+template <class Char = char>
+class pointer;
+
+template <class Char = char>
+class pointer_set;
+
+template <class Char = char>
+class frozen;
+
+template <class Json>
+class patcher;
+
 template <class Char, memory_policy Policy, class Allocator = new_allocator_t>
 class value final : public traits<Allocator>::reference {
 public:
@@ -219,81 +584,129 @@ public:
     using array_type = vector_t<self, Allocator>;
     using string_type = conditional_t<Policy == view, string_view_t, string_t>;
     using size_type = uint32_t;
+    using index_type = hash_index<Char, Allocator>;
     const static self default_value;
+    constexpr static size_type hash_threshold = 16u;
 
 protected:
+    union number_cache {
+        int64_t i;
+        uint64_t u;
+        float64_t f;
+    };
+
+    /* 数值原文之后紧跟解码结果, 原文保留用于序列化; 原文的长度放在结点头部 */
+    struct number_impl final {
+        Char const* text;
+        number_cache cache;
+    };
+
+    /* 建立索引的对象把成员连同索引移到堆上, storage 中只留指针 */
+    struct indexed_object final {
+        object_type members;
+        index_type index;
+
+        ALWAYS_INLINE indexed_object(object_type&& object, allocator_type& allocator)
+                : members(qlib::move(object)), index(allocator) {}
+    };
+
+    /* 头部 8 字节: 类型, 数值缓存类型, 对象是否已建立索引, 数值原文的长度 */
     value_enum _type{value_enum::null};
-    using impl_type = storage<object_type, array_type, string_t, string_view_t>;
+    number_enum _number{number_enum::none};
+    bool_t _indexed{False};
+    size_type _length{0u};
+    using impl_type =
+        storage<object_type, array_type, string_t, string_view_t, number_impl, indexed_object*>;
     impl_type _impl{};
 
     friend class parser<self>;
+    friend class stream_parser<self>;
+    friend class document_view<Char>;
+    template <class, memory_policy, class>
+    friend class value;
+    template <class, class>
+    friend class compact;
+    friend class pointer<Char>;
+    friend class frozen<Char>;
+    template <class>
+    friend class patcher;
 
-    struct FixedOutStream final : public traits<Allocator>::reference {
-    protected:
-        Char* _impl{nullptr};
-        size_type _size{0u};
-        size_type _capacity{0u};
+    NODISCARD ALWAYS_INLINE allocator_type& _allocator() noexcept {
+        return static_cast<base&>(*this);
+    }
+    NODISCARD ALWAYS_INLINE allocator_type& _allocator() const noexcept {
+        return static_cast<base&>(const_cast<self&>(*this));
+    }
 
-        NODISCARD ALWAYS_INLINE allocator_type& _allocator() noexcept {
-            return static_cast<base&>(*this);
-        }
-        NODISCARD ALWAYS_INLINE allocator_type& _allocator() const noexcept {
-            return static_cast<base&>(const_cast<self&>(*this));
-        }
+    NODISCARD ALWAYS_INLINE indexed_object* _indexed_object() const noexcept {
+        return *(indexed_object* const*)(&_impl);
+    }
 
-    public:
-        using base = typename traits<Allocator>::reference;
-
-        ALWAYS_INLINE constexpr explicit FixedOutStream(size_type capacity) noexcept(
-            is_nothrow_constructible_v<base>)
-                : _impl(_allocator().template allocate<Char>(capacity + 1u)), _size(0u),
-                  _capacity(capacity) {}
-
-        ALWAYS_INLINE constexpr FixedOutStream(size_type capacity, Allocator& allocator) noexcept(
-            is_nothrow_constructible_v<base, Allocator&>)
-                : base(allocator), _impl(_allocator().template allocate<Char>(capacity + 1u)),
-                  _size(0u), _capacity(capacity) {}
-
-        FixedOutStream(FixedOutStream const&) = delete;
-        FixedOutStream& operator=(FixedOutStream const&) = delete;
-        ALWAYS_INLINE FixedOutStream(FixedOutStream&& o)
-                : base(qlib::move(o)), _impl(o._impl), _size(o._size), _capacity(o._capacity) {
-            o._impl = nullptr;
-            o._size = 0u;
-            o._capacity = 0u;
-        }
-
-        ALWAYS_INLINE FixedOutStream& operator=(FixedOutStream&& o) noexcept {
-            this->~FixedOutStream();
-            new (this) FixedOutStream(qlib::move(o));
-            return *this;
+    NODISCARD ALWAYS_INLINE object_type& _members() const noexcept {
+        if (_indexed) {
+            return _indexed_object()->members;
         }
+        return *(object_type*)(&_impl);
+    }
 
-        ALWAYS_INLINE ~FixedOutStream() {
-            _allocator().template deallocate<Char>(_impl, _capacity);
-            _impl = nullptr;
-            _size = 0u;
-            _capacity = 0u;
-        }
+    NODISCARD ALWAYS_INLINE index_type* _index() const noexcept {
+        return _indexed ? &_indexed_object()->index : nullptr;
+    }
 
-        ALWAYS_INLINE FixedOutStream& operator<<(string_view_t s) {
-            size_type new_size = _size + s.size();
-            throw_if(new_size > _capacity);
-            qlib::copy(s.begin(), s.end(), _impl + _size);
-            _size = new_size;
-            return *this;
+    /* 内部访问, 不使索引失效 */
+    NODISCARD ALWAYS_INLINE object_type& _object() {
+        throw_if(_type != value_enum::object, "not object");
+        return _members();
+    }
+
+    /* 第一次建立索引时成员移入 indexed_object, 之前取得的 object() 引用随之失效,
+     * 成员本身不移动 */
+    ALWAYS_INLINE void _build_index() {
+        if (!_indexed) {
+            auto& allocator = _allocator();
+            auto& object = *(object_type*)(&_impl);
+            auto indexed = allocator.template allocate<indexed_object>(1u);
+            allocator.construct(indexed, qlib::move(object), allocator);
+            object.~object_type();
+            new (&_impl) indexed_object*(indexed);
+            _indexed = True;
         }
+        auto indexed = _indexed_object();
+        indexed->index.update(indexed->members);
+    }
 
-        NODISCARD ALWAYS_INLINE bool_t operator==(string_view_t s) const {
-            return _size == s.size() && equal(s.begin(), s.end(), _impl);
+    ALWAYS_INLINE void _destroy_object() noexcept {
+        if (_indexed) {
+            auto& allocator = _allocator();
+            auto indexed = _indexed_object();
+            allocator.destroy(indexed);
+            allocator.template deallocate<indexed_object>(indexed, 1u);
+            _indexed = False;
+        } else {
+            ((object_type*)&_impl)->~object_type();
         }
-    };
+    }
 
-    NODISCARD ALWAYS_INLINE allocator_type& _allocator() noexcept {
-        return static_cast<base&>(*this);
+    template <class Object>
+    NODISCARD ALWAYS_INLINE static auto _linear_find(Object& object, string_view_t key) {
+        auto it = object.begin();
+        for (; it != object.end(); ++it) {
+            if (it->key == key) {
+                break;
+            }
+        }
+        return it;
     }
-    NODISCARD ALWAYS_INLINE allocator_type& _allocator() const noexcept {
-        return static_cast<base&>(const_cast<self&>(*this));
+
+    /* 哈希已由调用方算好, 见 pointer */
+    NODISCARD ALWAYS_INLINE size_type _find(string_view_t key, uint32_t hash) const noexcept {
+        auto& object = _members();
+        auto index = _index();
+        if (index != nullptr && index->size() == object.size()) {
+            return index->find(object, key, hash);
+        }
+        auto it = _linear_find(object, key);
+        return it != object.end() ? size_type(it - object.begin()) : index_type::npos;
     }
 
     template <class Iter1, class Iter2>
@@ -344,129 +757,495 @@ protected:
         return result;
     }
 
+    /* 整段复制两个转义之间的原文, 转义序列逐个解码 */
     template <class Iter1, class Iter2>
     ALWAYS_INLINE static constexpr int32_t _parse_string(string_t* value, Iter1 begin, Iter2 end) {
         int32_t result{0u};
 
-        auto start = begin;
-        while (begin < end && result == 0) {
-            if (*begin != '\\') {
-                ++begin;
-            } else {
-                *value << string_view_t{start, begin};
-                ++begin;
-                switch (*begin) {
-                    case '"':
-                    case '\\':
-                    case '/':
-                        *value << *begin;
-                        ++begin;
-                        break;
-                    case 'b':
-                        *value << '\b';
-                        ++begin;
-                        break;
-                    case 'f':
-                        *value << '\f';
-                        ++begin;
-                        break;
-                    case 'n':
-                        *value << '\n';
-                        ++begin;
-                        break;
-                    case 'r':
-                        *value << '\r';
-                        ++begin;
-                        break;
-                    case 't':
-                        *value << '\t';
-                        ++begin;
-                        break;
-                    case 'u': {
-                        ++begin;
-                        uint32_t code{0u};
-                        result = _parse_unicode(code, begin, end);
-                        if (0 != result) {
-                            break;
-                        }
-                        if (code <= 0x7f) {
-                            *value << (char)code;
-                        } else if (code <= 0x7ff) {
-                            *value << (Char)(0xc0 | (code >> 6));
-                            *value << (Char)(0x80 | (code & 0x3f));
-                        } else if (code <= 0xffff) {
-                            *value << (Char)(0xe0 | (code >> 12));
-                            *value << (Char)(0x80 | ((code >> 6) & 0x3f));
-                            *value << (Char)(0x80 | (code & 0x3f));
-                        } else if (code <= 0x10ffff) {
-                            *value << (Char)(0xf0 | (code >> 18));
-                            *value << (Char)(0x80 | ((code >> 12) & 0x3f));
-                            *value << (Char)(0x80 | ((code >> 6) & 0x3f));
-                            *value << (Char)(0x80 | (code & 0x3f));
-                        } else {
-                            result = -1;
-                        }
+        auto first = &*begin;
+        auto last = first + (end - begin);
+        while (first < last && result == 0) {
+            auto n = __backslash_prefix(first, last);
+            *value << string_view_t{first, first + n};
+            first += n;
+            if (first == last || ++first == last) {
+                break;
+            }
+            switch (*first) {
+                case 'b':
+                    *value << '\b';
+                    ++first;
+                    break;
+                case 'f':
+                    *value << '\f';
+                    ++first;
+                    break;
+                case 'n':
+                    *value << '\n';
+                    ++first;
+                    break;
+                case 'r':
+                    *value << '\r';
+                    ++first;
+                    break;
+                case 't':
+                    *value << '\t';
+                    ++first;
+                    break;
+                case 'u': {
+                    ++first;
+                    uint32_t code{0u};
+                    result = _parse_unicode(code, first, last);
+                    if (0 != result) {
                         break;
                     }
-                    default: {
-                        *value << *begin;
-                        ++begin;
+                    Char utf8[4]{};
+                    size_t size{0u};
+                    if (code <= 0x7f) {
+                        utf8[size++] = (Char)code;
+                    } else if (code <= 0x7ff) {
+                        utf8[size++] = (Char)(0xc0 | (code >> 6));
+                        utf8[size++] = (Char)(0x80 | (code & 0x3f));
+                    } else if (code <= 0xffff) {
+                        utf8[size++] = (Char)(0xe0 | (code >> 12));
+                        utf8[size++] = (Char)(0x80 | ((code >> 6) & 0x3f));
+                        utf8[size++] = (Char)(0x80 | (code & 0x3f));
+                    } else if (code <= 0x10ffff) {
+                        utf8[size++] = (Char)(0xf0 | (code >> 18));
+                        utf8[size++] = (Char)(0x80 | ((code >> 12) & 0x3f));
+                        utf8[size++] = (Char)(0x80 | ((code >> 6) & 0x3f));
+                        utf8[size++] = (Char)(0x80 | (code & 0x3f));
+                    } else {
+                        result = -1;
+                        break;
                     }
+                    *value << string_view_t{utf8, utf8 + size};
+                    break;
+                }
+                default: {
+                    /* '"', '\\', '/' 以及其他字符原样保留 */
+                    *value << *first;
+                    ++first;
                 }
-                start = begin;
             }
         }
-        if (!result) {
-            *value << string_view_t{start, begin};
-        }
         return result;
     }
 
-    template <class T = string_type>
-    ALWAYS_INLINE constexpr enable_if_t<is_same_v<T, string_view_t>, void> _init_string_type(
-        string_view_t value, allocator_type&) {
-        new (&_impl) string_type(value);
+    NODISCARD ALWAYS_INLINE number_cache& _number_cache() const noexcept {
+        return ((number_impl*)(&_impl))->cache;
     }
 
-    template <class T = string_type>
-    ALWAYS_INLINE constexpr enable_if_t<!is_same_v<T, string_view_t>, void> _init_string_type(
-        string_view_t value, allocator_type& allocator) {
-        new (&_impl) string_type(value, allocator);
+    NODISCARD ALWAYS_INLINE string_view_t _number_text() const noexcept {
+        auto text = ((number_impl const*)(&_impl))->text;
+        return string_view_t(text, text + _length);
     }
 
-    template <class T = string_type>
-    ALWAYS_INLINE constexpr enable_if_t<is_same_v<T, string_view_t>, void> _object_emplace(
-        object_type& object, string_view_t key) {
-        object.emplace_back(key, self(_allocator()));
+    /* number 与 copy 策略下的 number_ref 持有原文, view 策略的 number_ref 引用输入 */
+    NODISCARD ALWAYS_INLINE bool_t _owns_number() const noexcept {
+        return _type == value_enum::number || !is_same_v<string_type, string_view_t>;
     }
 
-    template <class T = string_type>
-    ALWAYS_INLINE constexpr enable_if_t<!is_same_v<T, string_view_t>, void> _object_emplace(
-        object_type& object, string_view_t key) {
-        object.emplace_back(string_t(key, _allocator()), self(_allocator()));
+    /* 调用前先设置 _type */
+    ALWAYS_INLINE void _init_number(string_view_t text, allocator_type& allocator) {
+        auto& number = *(number_impl*)(&_impl);
+        _length = size_type(text.size());
+        number.cache.u = 0u;
+        if (_owns_number()) {
+            auto impl = allocator.template allocate<Char>(_length + 1u);
+            qlib::copy(text.begin(), text.end(), impl);
+            impl[_length] = '\0';
+            number.text = impl;
+        } else {
+            number.text = text.data();
+        }
     }
 
-public:
-    template <class T>
-    class value_ref final : public object {
-    public:
-        using self = value_ref;
-        using value_type = T;
+    ALWAYS_INLINE void _destroy_number() noexcept {
+        if (_owns_number()) {
+            auto text = const_cast<Char*>(((number_impl*)(&_impl))->text);
+            _allocator().template deallocate<Char>(text, _length + 1u);
+        }
+    }
 
-    protected:
-        mutable T _impl;
+    /* 整数按符号存为 int64/uint64, 其余存为 float64; 无法解码时返回 none */
+    NODISCARD static number_enum _decode_number(string_view_t text, number_cache& cache) noexcept {
+        auto first = text.begin();
+        auto last = text.end();
+        bool_t negative = first < last && *first == '-';
+        auto p = first + negative;
+        uint64_t u{0u};
+        for (; p < last && is_digit(*p); ++p) {
+            uint64_t digit = uint64_t(*p - '0');
+            if (u > (uint64_t(-1) - digit) / 10u) {
+                break;
+            }
+            u = u * 10u + digit;
+        }
+        if (p == last && p > first + negative) {
+            if (!negative) {
+                cache.u = u;
+                return number_enum::uint64;
+            } else if (u <= (uint64_t(1) << 63)) {
+                cache.i = int64_t(uint64_t(0) - u);
+                return number_enum::int64;
+            }
+        }
+        float64_t f{0};
+        if (first < last && string::from_chars(first, last, f) == last) {
+            cache.f = f;
+            return number_enum::float64;
+        }
+        return number_enum::none;
+    }
 
-    public:
-        value_ref() = delete;
-        value_ref(self const&) = delete;
-        ALWAYS_INLINE value_ref(self&&) = default;
-        self& operator=(self const&) = delete;
-        ALWAYS_INLINE self& operator=(self&&) = default;
+    ALWAYS_INLINE void _cache_number() noexcept {
+        _number = _decode_number(_number_text(), _number_cache());
+    }
 
-        template <class... Args>
-        ALWAYS_INLINE value_ref(Args&&... args) : _impl(qlib::forward<Args>(args)...) {}
+    /* 未缓存时现场解码, 不修改节点 */
+    NODISCARD ALWAYS_INLINE number_enum _number_value(number_cache& cache) const noexcept {
+        cache = _number_cache();
+        return _number != number_enum::none ? _number : _decode_number(_number_text(), cache);
+    }
 
-        ALWAYS_INLINE value_type operator*() const noexcept { return qlib::move(_impl); }
+    /* 整数之间精确比较; 整数与浮点数比较时, 浮点数必须恰好等于该整数 */
+    NODISCARD static bool_t _number_equal(number_enum ta,
+                                          number_cache a,
+                                          number_enum tb,
+                                          number_cache b) noexcept {
+        if (ta == number_enum::none || tb == number_enum::none) {
+            return False;
+        }
+        if (ta == tb) {
+            return ta == number_enum::float64 ? a.f == b.f : a.u == b.u;
+        }
+        if (tb == number_enum::float64) {
+            auto t = ta;
+            ta = tb, tb = t;
+            auto c = a;
+            a = b, b = c;
+        }
+        if (ta == number_enum::float64) {
+            auto f = a.f;
+            if (tb == number_enum::uint64) {
+                return f >= 0.0 && f < 18446744073709551616.0 && uint64_t(f) == b.u &&
+                       float64_t(uint64_t(f)) == f;
+            }
+            return f >= -9223372036854775808.0 && f < 9223372036854775808.0 &&
+                   int64_t(f) == b.i && float64_t(int64_t(f)) == f;
+        }
+        auto i = ta == number_enum::int64 ? a.i : b.i;
+        auto u = ta == number_enum::int64 ? b.u : a.u;
+        return i >= 0 && uint64_t(i) == u;
+    }
+
+    /* 原文相同即相等; 含转义时解码后比较, 例如 "\u0041" 与 "A" */
+    NODISCARD static bool_t _string_equal(string_view_t a, string_view_t b) {
+        if (a == b) {
+            return True;
+        }
+        if (__backslash_prefix(a.begin(), a.end()) == a.size() &&
+            __backslash_prefix(b.begin(), b.end()) == b.size()) {
+            return False;
+        }
+        using text_type = value<Char, view>;
+        auto x = text_type(a).template get<string::value<Char>>();
+        auto y = text_type(b).template get<string::value<Char>>();
+        return x == string_view_t(y.begin(), y.end());
+    }
+
+    using scratch_index = hash_index<Char, new_allocator_t>;
+
+    /* 比较时按键查找成员的下标: 先试 hint (键顺序相同时总是命中), 再用已有的索引,
+     * 没有索引的大对象在 scratch 中临时建立 */
+    NODISCARD size_type _member(string_view_t key, size_type hint, scratch_index& scratch) const {
+        auto& object = this->object();
+        if (hint < object.size() && object[hint].key == key) {
+            return hint;
+        }
+        auto index = _index();
+        if (index != nullptr && index->size() == object.size()) {
+            return index->find(object, key);
+        }
+        if (object.size() >= hash_threshold) {
+            if (scratch.size() != object.size()) {
+                scratch.update(object);
+            }
+            return scratch.find(object, key);
+        }
+        auto it = _linear_find(object, key);
+        return it != object.end() ? size_type(it - object.begin()) : index_type::npos;
+    }
+
+    /* 按键找到尚未匹配的成员并标记; 查到的成员已被重复的键占用时向后找同名的下一个 */
+    NODISCARD size_type _unmatched_member(string_view_t key,
+                                          size_type hint,
+                                          scratch_index& scratch,
+                                          __member_marks& marks) const {
+        auto& object = this->object();
+        auto pos = _member(key, hint, scratch);
+        if (pos == index_type::npos || marks.mark(pos)) {
+            return pos;
+        }
+        for (++pos; pos < object.size(); ++pos) {
+            if (object[pos].key == key && marks.mark(pos)) {
+                return pos;
+            }
+        }
+        return index_type::npos;
+    }
+
+    ALWAYS_INLINE static void _skip_space(Char const*& p, Char const* last) noexcept {
+        while (p < last && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+            ++p;
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _expect(Char const*& p, Char const* last, Char c) noexcept {
+        _skip_space(p, last);
+        if (p < last && *p == c) {
+            ++p;
+            return True;
+        }
+        return False;
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _literal(Char const*& p,
+                                                   Char const* last,
+                                                   string_view_t literal) noexcept {
+        if (size_t(last - p) < literal.size() || string_view_t(p, p + literal.size()) != literal) {
+            return False;
+        }
+        p += literal.size();
+        return True;
+    }
+
+    /* 文本与节点保存的原文逐字节相同时跳过扫描; 原文不会以转义用的 '\\' 结尾, 其后的 '"' 即右引号 */
+    NODISCARD ALWAYS_INLINE static bool_t _same_string(Char const*& p,
+                                                       Char const* last,
+                                                       string_view_t raw) noexcept {
+        if (size_t(last - p) > raw.size() && p[raw.size()] == '"' &&
+            string_view_t(p, p + raw.size()) == raw) {
+            p += raw.size() + 1u;
+            return True;
+        }
+        return False;
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_number_char(Char c) noexcept {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    /* 与文本中的下一个值比较, 遇到第一处不同立即返回 False */
+    NODISCARD bool_t _match(Char const*& p, Char const* last) const {
+        _skip_space(p, last);
+        if (p == last) {
+            return False;
+        }
+        switch (*p) {
+            case '{': {
+                if (_type != value_enum::object) {
+                    return False;
+                }
+                ++p;
+                auto& object = this->object();
+                if (_expect(p, last, '}')) {
+                    return object.empty();
+                }
+                scratch_index scratch;
+                __member_marks marks(object.size());
+                size_type hint{0u};
+                size_type count{0u};
+                do {
+                    if (!_expect(p, last, '"')) {
+                        return False;
+                    }
+                    size_type pos{hint};
+                    if (hint < object.size() && _same_string(p, last, object[hint].key)) {
+                        if (!marks.mark(hint)) {
+                            string_view_t key(object[hint].key.begin(), object[hint].key.end());
+                            pos = _unmatched_member(key, hint, scratch, marks);
+                        }
+                    } else {
+                        string_view_t key;
+                        if (!_match_string(p, last, key)) {
+                            return False;
+                        }
+                        pos = _unmatched_member(key, hint, scratch, marks);
+                    }
+                    if (!_expect(p, last, ':')) {
+                        return False;
+                    }
+                    if (pos == index_type::npos || !object[pos].value._match(p, last)) {
+                        return False;
+                    }
+                    hint = pos + 1u;
+                    ++count;
+                } while (_expect(p, last, ','));
+                return _expect(p, last, '}') && count == object.size();
+            }
+            case '[': {
+                if (_type != value_enum::array) {
+                    return False;
+                }
+                ++p;
+                auto& array = this->array();
+                if (_expect(p, last, ']')) {
+                    return array.empty();
+                }
+                size_type i{0u};
+                do {
+                    if (i >= array.size() || !array[i++]._match(p, last)) {
+                        return False;
+                    }
+                } while (_expect(p, last, ','));
+                return _expect(p, last, ']') && i == array.size();
+            }
+            case '"': {
+                if (_type != value_enum::string) {
+                    return False;
+                }
+                auto& raw = *(string_type*)(&_impl);
+                string_view_t text;
+                return _same_string(++p, last, raw) ||
+                       (_match_string(p, last, text) && _string_equal(raw, text));
+            }
+            case 't':
+            case 'f': {
+                return _type == value_enum::boolean && get<bool_t>() == (*p == 't') &&
+                       _literal(p, last, *p == 't' ? string::true_str<Char> : string::false_str<Char>);
+            }
+            case 'n': {
+                return _type == value_enum::null && _literal(p, last, string::null_str<Char>);
+            }
+            default: {
+                if (_type != value_enum::number && _type != value_enum::number_ref) {
+                    return False;
+                }
+                auto first = p;
+                auto raw = _number_text();
+                if (size_t(last - p) >= raw.size() && string_view_t(p, p + raw.size()) == raw &&
+                    (size_t(last - p) == raw.size() || !_is_number_char(p[raw.size()]))) {
+                    p += raw.size();
+                    return True;
+                }
+                while (p < last && _is_number_char(*p)) {
+                    ++p;
+                }
+                number_cache a, b;
+                auto tb = _decode_number(string_view_t(first, p), b);
+                return _number_equal(_number_value(a), a, tb, b);
+            }
+        }
+    }
+
+    /* p 位于左引号之后, 返回引号内的原文 */
+    NODISCARD ALWAYS_INLINE static bool_t _match_string(Char const*& p,
+                                                        Char const* last,
+                                                        string_view_t& text) noexcept {
+        auto first = p;
+        while (p < last && *p != '"') {
+            p += (*p == '\\') ? 2 : 1;
+        }
+        if (p >= last) {
+            return False;
+        }
+        text = string_view_t(first, p++);
+        return True;
+    }
+
+    template <class T>
+    ALWAYS_INLINE void _seed_number(T value) noexcept {
+        auto& cache = _number_cache();
+        if (is_floating_point_v<T>) {
+            /* float 的最短文本与其 double 值不一致, 只缓存 double */
+            if (sizeof(T) == sizeof(float64_t)) {
+                cache.f = float64_t(value);
+                _number = number_enum::float64;
+            }
+        } else if (is_signed_v<T> && int64_t(value) < 0) {
+            cache.i = int64_t(value);
+            _number = number_enum::int64;
+        } else {
+            cache.u = uint64_t(value);
+            _number = number_enum::uint64;
+        }
+    }
+
+    /* 缓存与目标类型不匹配时返回 False, 交由原文解码以保持原有语义 */
+    template <class T>
+    NODISCARD ALWAYS_INLINE bool_t _from_cache(T& value) const noexcept {
+        auto& cache = _number_cache();
+        switch (_number) {
+            case number_enum::uint64: {
+                value = T(cache.u);
+                return True;
+            }
+            case number_enum::int64: {
+                if (is_unsigned_v<T>) {
+                    return False;
+                }
+                value = T(cache.i);
+                return True;
+            }
+            case number_enum::float64: {
+                if (!is_same_v<T, float64_t>) {
+                    return False;
+                }
+                value = T(cache.f);
+                return True;
+            }
+            default:
+                return False;
+        }
+    }
+
+    template <class T = string_type>
+    ALWAYS_INLINE constexpr enable_if_t<is_same_v<T, string_view_t>, void> _init_string_type(
+        string_view_t value, allocator_type&) {
+        new (&_impl) string_type(value);
+    }
+
+    template <class T = string_type>
+    ALWAYS_INLINE constexpr enable_if_t<!is_same_v<T, string_view_t>, void> _init_string_type(
+        string_view_t value, allocator_type& allocator) {
+        new (&_impl) string_type(value, allocator);
+    }
+
+    template <class T = string_type>
+    ALWAYS_INLINE constexpr enable_if_t<is_same_v<T, string_view_t>, void> _object_emplace(
+        object_type& object, string_view_t key) {
+        object.emplace_back(key, self(_allocator()));
+    }
+
+    template <class T = string_type>
+    ALWAYS_INLINE constexpr enable_if_t<!is_same_v<T, string_view_t>, void> _object_emplace(
+        object_type& object, string_view_t key) {
+        object.emplace_back(string_t(key, _allocator()), self(_allocator()));
+    }
+
+public:
+    template <class T>
+    class value_ref final : public object {
+    public:
+        using self = value_ref;
+        using value_type = T;
+
+    protected:
+        mutable T _impl;
+
+    public:
+        value_ref() = delete;
+        value_ref(self const&) = delete;
+        ALWAYS_INLINE value_ref(self&&) = default;
+        self& operator=(self const&) = delete;
+        ALWAYS_INLINE self& operator=(self&&) = default;
+
+        template <class... Args>
+        ALWAYS_INLINE value_ref(Args&&... args) : _impl(qlib::forward<Args>(args)...) {}
+
+        ALWAYS_INLINE value_type operator*() const noexcept { return qlib::move(_impl); }
     };
 
     // template <class Enable = enable_if_t<is_constructible_v<base>>>
@@ -531,7 +1310,19 @@ public:
 
     template <class T, class Enable = enable_if_t<is_number_v<T>>>
     constexpr value(T value) : _type(value_enum::number) {
-        new (&_impl) string_t(string_t::from(value));
+        auto text = string_t::from(value);
+        _init_number(string_view_t(text.begin(), text.end()), _allocator());
+        _seed_number(value);
+    }
+
+    /* 文本从 allocator 分配, pool_allocator 同样适用 */
+    template <class T, class Enable = enable_if_t<is_number_v<T>>>
+    constexpr value(T value, allocator_type& allocator)
+            : base(allocator), _type(value_enum::number) {
+        Char s[32]{};
+        auto last = string::to_chars(s, s + 32, value);
+        _init_number(string_view_t(s, last), allocator);
+        _seed_number(value);
     }
 
     // template <class Enable = enable_if_t<is_constructible_v<base>>>
@@ -546,38 +1337,98 @@ public:
             string_view_t(value ? string::true_str<char_type> : string::false_str<char_type>);
     }
 
-    constexpr value(self const& o) : base(o), _type(o._type) {
+    constexpr value(self const& o) : base(o), _type(o._type), _number(o._number) {
         switch (_type) {
             case value_enum::object: {
-                new (&_impl) object_type(*(object_type*)(&o._impl));
+                new (&_impl) object_type(o._members());
                 break;
             }
             case value_enum::array: {
                 new (&_impl) array_type(*(array_type*)(&o._impl));
                 break;
             }
-            case value_enum::string: {
+            case value_enum::string:
+            case value_enum::binary: {
                 new (&_impl) string_type(*(string_type*)(&o._impl));
                 break;
             }
-            case value_enum::number: {
-                new (&_impl) string_t(*(string_t*)(&o._impl));
+            case value_enum::number:
+            case value_enum::number_ref: {
+                _init_number(o._number_text(), _allocator());
+                _number_cache() = o._number_cache();
                 break;
             }
             case value_enum::boolean: {
                 new (&_impl) string_view_t(*(string_view_t*)(&o._impl));
                 break;
             }
-            case value_enum::number_ref: {
-                new (&_impl) string_type(*(string_type*)(&o._impl));
-                break;
-            }
             default:;
         }
     }
 
-    ALWAYS_INLINE CONSTEXPR value(self&& o) : base(qlib::move(o)), _type{o._type}, _impl{qlib::move(o._impl)} {
+    ALWAYS_INLINE CONSTEXPR value(self&& o)
+            : base(qlib::move(o)),
+              _type{o._type},
+              _number{o._number},
+              _indexed{o._indexed},
+              _length{o._length},
+              _impl{qlib::move(o._impl)} {
         o._type = value_enum::null;
+        o._indexed = False;
+    }
+
+    /* 深拷贝, 新结点从 allocator 分配, 可以跨 memory_policy 与分配器; 数值总是复制原文,
+     * view 策略的键与字符串仍引用原来的文本 */
+    template <memory_policy P, class A>
+    value(value<Char, P, A> const& o, allocator_type& allocator) : base(allocator) {
+        switch (o._type) {
+            case value_enum::object: {
+                auto& from = o.object();
+                _type = value_enum::object;
+                new (&_impl) object_type(from.size(), allocator);
+                auto& object = *(object_type*)(&_impl);
+                for (auto& item : from) {
+                    _object_emplace(object, string_view_t(item.key.begin(), item.key.end()));
+                    object.back().value = self(item.value, allocator);
+                }
+                break;
+            }
+            case value_enum::array: {
+                auto& from = o.array();
+                _type = value_enum::array;
+                new (&_impl) array_type(from.size(), allocator);
+                auto& array = *(array_type*)(&_impl);
+                for (auto& item : from) {
+                    array.emplace_back(item, allocator);
+                }
+                break;
+            }
+            case value_enum::string: {
+                _type = value_enum::string;
+                _init_string_type(o.template get<string_view_t>(), allocator);
+                break;
+            }
+            case value_enum::binary: {
+                _type = value_enum::binary;
+                _init_string_type(o.binary(), allocator);
+                break;
+            }
+            case value_enum::number:
+            case value_enum::number_ref: {
+                _type = value_enum::number;
+                _init_number(o._number_text(), allocator);
+                _number = o._number;
+                _number_cache().u = o._number_cache().u;
+                break;
+            }
+            case value_enum::boolean: {
+                _type = value_enum::boolean;
+                new (&_impl) string_view_t(o.template get<bool_t>() ? string::true_str<char_type>
+                                                                    : string::false_str<char_type>);
+                break;
+            }
+            default:;
+        }
     }
 
 #ifdef _INITIALIZER_LIST
@@ -593,29 +1444,27 @@ public:
     ~value() noexcept {
         switch (_type) {
             case value_enum::object: {
-                ((object_type*)&_impl)->~object_type();
+                _destroy_object();
                 break;
             }
             case value_enum::array: {
                 ((array_type*)&_impl)->~array_type();
                 break;
             }
-            case value_enum::string: {
+            case value_enum::string:
+            case value_enum::binary: {
                 ((string_type*)&_impl)->~string_type();
                 break;
             }
-            case value_enum::number: {
-                ((string_t*)&_impl)->~string_t();
+            case value_enum::number:
+            case value_enum::number_ref: {
+                _destroy_number();
                 break;
             }
             case value_enum::boolean: {
                 ((string_view_t*)&_impl)->~string_view_t();
                 break;
             }
-            case value_enum::number_ref: {
-                ((string_type*)&_impl)->~string_type();
-                break;
-            }
             default:;
         }
     }
@@ -649,21 +1498,23 @@ public:
 
     template <class T>
     NODISCARD ALWAYS_INLINE constexpr enable_if_t<is_number_v<T>, T> get() const {
-        if (likely(_type == value_enum::number_ref)) {
-            auto& value = *(string_type*)(&_impl);
-            T value_number{};
-            converter<T>::decode(value_number, value.begin(), value.end());
-            return value_number;
-            // return (*(string_type*)(&_impl)).template to<T>();
-        } else if (likely(_type == value_enum::number)) {
-            auto& value = *(string_t*)(&_impl);
-            T value_number{};
+        throw_if(_type != value_enum::number_ref && _type != value_enum::number, "not number");
+        T value_number{};
+        if (!_from_cache(value_number)) {
+            auto value = _number_text();
             converter<T>::decode(value_number, value.begin(), value.end());
-            return value_number;
-            // return (*(string_t*)(&_impl)).template to<T>();
-        } else {
-            __throw("not number");
         }
+        return value_number;
+    }
+
+    /* 非 const 访问在首次读取时缓存解码结果 */
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_number_v<T>, T> get() {
+        throw_if(_type != value_enum::number_ref && _type != value_enum::number, "not number");
+        if (_number == number_enum::none) {
+            _cache_number();
+        }
+        return const_cast<self const&>(*this).template get<T>();
     }
 
     template <class T>
@@ -703,32 +1554,54 @@ public:
         return get<T>();
     }
 
-    NODISCARD ALWAYS_INLINE constexpr self const& operator[](string_view_t key) const {
-        for (auto const& pair : object()) {
-            if (pair.key == key) {
-                return pair.value;
-            }
+    /* 键数不少于 hash_threshold 时建立哈希索引; const 访问只使用已有且未过期的索引 */
+    NODISCARD ALWAYS_INLINE typename object_type::iterator find(string_view_t key) {
+        auto& object = _object();
+        if (_indexed || object.size() >= hash_threshold) {
+            _build_index();
+            auto& members = _members();
+            auto pos = _index()->find(members, key);
+            return pos == index_type::npos ? members.end() : members.begin() + pos;
         }
-        return default_value;
+        return _linear_find(object, key);
     }
 
-    NODISCARD ALWAYS_INLINE constexpr self& operator[](string_view_t key) {
+    NODISCARD ALWAYS_INLINE typename object_type::const_iterator find(string_view_t key) const {
         auto& object = this->object();
-        for (auto& pair : object) {
-            if (pair.key == key) {
-                return pair.value;
-            }
+        auto index = _index();
+        if (index != nullptr && index->size() == object.size()) {
+            auto pos = index->find(object, key);
+            return pos == index_type::npos ? object.end() : object.begin() + pos;
+        }
+        return _linear_find(object, key);
+    }
+
+    NODISCARD ALWAYS_INLINE constexpr self const& operator[](string_view_t key) const {
+        auto it = find(key);
+        return it != object().end() ? it->value : default_value;
+    }
+
+    NODISCARD ALWAYS_INLINE constexpr self& operator[](string_view_t key) {
+        auto it = find(key);
+        auto& object = _object();
+        if (it != object.end()) {
+            return it->value;
         }
         _object_emplace(object, key);
         return object.back().value;
     }
 
+    /* 可写的成员可能被改动键或顺序, 已有的哈希索引随之失效 */
     NODISCARD ALWAYS_INLINE object_type& object() {
-        throw_if(_type != value_enum::object, "not object");
-        return *(object_type*)(&_impl);
+        auto& object = _object();
+        auto index = _index();
+        if (index != nullptr) {
+            index->invalidate();
+        }
+        return object;
     }
     NODISCARD ALWAYS_INLINE object_type const& object() const {
-        return const_cast<self&>(*this).object();
+        return const_cast<self&>(*this)._object();
     }
 
     NODISCARD ALWAYS_INLINE array_type& array() {
@@ -740,6 +1613,49 @@ public:
         return const_cast<self&>(*this).array();
     }
 
+    /* 二进制数据 (MessagePack bin, CBOR byte string), view 策略下直接引用输入 */
+    NODISCARD ALWAYS_INLINE string_view_t binary() const {
+        throw_if(_type != value_enum::binary, "not binary");
+        auto& bytes = *(string_type*)(&_impl);
+        return string_view_t(bytes.begin(), bytes.end());
+    }
+
+    NODISCARD ALWAYS_INLINE static self binary(string_view_t bytes, allocator_type& allocator) {
+        self value(allocator);
+        value._type = value_enum::binary;
+        value._init_string_type(bytes, allocator);
+        return value;
+    }
+
+    NODISCARD ALWAYS_INLINE allocator_type& allocator() const noexcept { return _allocator(); }
+
+    /* 以解码后的类型调用 func(int64_t), func(uint64_t) 或 func(float64_t), 未缓存时现场解码 */
+    template <class Func>
+    ALWAYS_INLINE void visit_number(Func&& func) const {
+        throw_if(_type != value_enum::number_ref && _type != value_enum::number, "not number");
+        auto type = _number;
+        auto cache = _number_cache();
+        if (type == number_enum::none) {
+            type = _decode_number(_number_text(), cache);
+        }
+        switch (type) {
+            case number_enum::int64: {
+                func(cache.i);
+                break;
+            }
+            case number_enum::uint64: {
+                func(cache.u);
+                break;
+            }
+            case number_enum::float64: {
+                func(cache.f);
+                break;
+            }
+            default:
+                __throw("not number");
+        }
+    }
+
 #ifdef _INITIALIZER_LIST
     NODISCARD ALWAYS_INLINE static self object(std::initializer_list<value_ref<pair>> list) {
         self value;
@@ -780,18 +1696,30 @@ public:
                 out << quote_str << *(string_type*)(&_impl) << quote_str;
                 break;
             }
-            case value_enum::number: {
-                out << *((string_t*)(&_impl));
-                break;
-            }
+            case value_enum::number:
             case value_enum::number_ref: {
-                out << *((string_type*)(&_impl));
+                out << _number_text();
                 break;
             }
             case value_enum::boolean: {
                 out << *((string_view_t*)(&_impl));
                 break;
             }
+            /* JSON 没有二进制类型, 输出为字节数组 */
+            case value_enum::binary: {
+                out << "[";
+                auto bytes = binary();
+                for (auto it = bytes.begin(); it != bytes.end(); ++it) {
+                    Char s[4];
+                    auto last = string::to_chars(s, s + 4, uint8_t(*it));
+                    if (it != bytes.begin()) {
+                        out << comma_str;
+                    }
+                    out << string_view_t(s, last);
+                }
+                out << "]";
+                break;
+            }
             case value_enum::array: {
                 out << "[";
                 auto& array = this->array();
@@ -830,17 +1758,83 @@ public:
 
     NODISCARD ALWAYS_INLINE explicit operator bool_t() const noexcept { return !empty(); }
 
+    /* 与文本按结构比较: 边解析边比较, 不序列化也不构造节点; 对象不要求键的顺序, 数值按值比较,
+     * 非法的文本视为不相等 */
     NODISCARD ALWAYS_INLINE bool_t operator==(string_view_t text) const {
-        FixedOutStream out(text.size());
+        auto p = text.begin();
         bool_t ok{False};
         try {
-            ok = (to(out) == text);
+            ok = _match(p, text.end());
+            _skip_space(p, text.end());
+            ok = ok && p == text.end();
         } catch (exception const& _) {
             ok = False;
         }
         return ok;
     }
 
+    /* 结构比较, 可以跨 memory_policy 与分配器 */
+    template <memory_policy P, class A>
+    NODISCARD bool_t operator==(value<Char, P, A> const& o) const {
+        auto is_number = [](value_enum type) {
+            return type == value_enum::number || type == value_enum::number_ref;
+        };
+        if (_type != o._type && !(is_number(_type) && is_number(o._type))) {
+            return False;
+        }
+        switch (_type) {
+            case value_enum::null:
+                return True;
+            case value_enum::boolean:
+                return get<bool_t>() == o.template get<bool_t>();
+            case value_enum::number:
+            case value_enum::number_ref: {
+                typename value<Char, P, A>::number_cache c;
+                auto tb = o._number_value(c);
+                number_cache a, b;
+                b.u = c.u;
+                return _number_equal(_number_value(a), a, tb, b);
+            }
+            case value_enum::string:
+                return _string_equal(get<string_view_t>(), o.template get<string_view_t>());
+            case value_enum::binary:
+                return binary() == o.binary();
+            case value_enum::array: {
+                auto& array = this->array();
+                auto& other = o.array();
+                if (array.size() != other.size()) {
+                    return False;
+                }
+                for (size_type i = 0u; i < array.size(); ++i) {
+                    if (!(array[i] == other[i])) {
+                        return False;
+                    }
+                }
+                return True;
+            }
+            case value_enum::object: {
+                auto& object = this->object();
+                auto& other = o.object();
+                if (object.size() != other.size()) {
+                    return False;
+                }
+                typename value<Char, P, A>::scratch_index scratch;
+                __member_marks marks(other.size());
+                size_type hint{0u};
+                for (auto& item : object) {
+                    string_view_t key(item.key.begin(), item.key.end());
+                    auto pos = o._unmatched_member(key, hint, scratch, marks);
+                    if (pos == index_type::npos || !(item.value == other[pos].value)) {
+                        return False;
+                    }
+                    hint = pos + 1u;
+                }
+                return True;
+            }
+        }
+        return False;
+    }
+
     template <class T>
     NODISCARD ALWAYS_INLINE bool_t operator!=(T const& o) const {
         return !(*this == o);
@@ -851,49 +1845,687 @@ template <class Char, memory_policy Policy, class Allocator>
 const typename value<Char, Policy, Allocator>::self value<Char, Policy, Allocator>::default_value =
     value<Char, Policy, Allocator>{};
 
-template <class Json>
-class parser final : public object {
-public:
-    using size_type = size_t;
-    using json_type = Json;
-    using allocator_type = typename Json::allocator_type;
-    using string_type = typename json_type::string_type;
-    using array_type = typename json_type::array_type;
-    using object_type = typename json_type::object_type;
-    using key_type = typename json_type::key_type;
-    using string_t = typename json_type::string_t;
-    using string_view_t = typename json_type::string_view_t;
-
+namespace simd {
+
+constexpr static size_t block_size = 64u;
+
+NODISCARD ALWAYS_INLINE static uint64_t prefix_xor(uint64_t bits) noexcept {
+#if defined(__PCLMUL__)
+    __m128i all_ones = _mm_set1_epi8('\xFF');
+    __m128i result = _mm_clmulepi64_si128(_mm_set_epi64x(0ULL, bits), all_ones, 0);
+    return uint64_t(_mm_cvtsi128_si64(result));
+#else
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+#endif
+}
+
+struct block final {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;
+    uint64_t space;
+};
+
+#if defined(__AVX2__)
+NODISCARD ALWAYS_INLINE static uint64_t _mask(__m256i lo, __m256i hi) noexcept {
+    return uint64_t(uint32_t(_mm256_movemask_epi8(lo))) |
+           (uint64_t(uint32_t(_mm256_movemask_epi8(hi))) << 32);
+}
+
+NODISCARD ALWAYS_INLINE static block classify(uint8_t const* p) noexcept {
+    __m256i lo = _mm256_loadu_si256((__m256i const*)(p));
+    __m256i hi = _mm256_loadu_si256((__m256i const*)(p + 32));
+    auto eq = [](__m256i v, char c) { return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)); };
+    // '[' | 0x20 == '{', ']' | 0x20 == '}'
+    __m256i lo_case = _mm256_or_si256(lo, _mm256_set1_epi8(0x20));
+    __m256i hi_case = _mm256_or_si256(hi, _mm256_set1_epi8(0x20));
+
+    block result;
+    result.quote = _mask(eq(lo, '"'), eq(hi, '"'));
+    result.backslash = _mask(eq(lo, '\\'), eq(hi, '\\'));
+    result.op = _mask(_mm256_or_si256(_mm256_or_si256(eq(lo_case, '{'), eq(lo_case, '}')),
+                                      _mm256_or_si256(eq(lo, ':'), eq(lo, ','))),
+                      _mm256_or_si256(_mm256_or_si256(eq(hi_case, '{'), eq(hi_case, '}')),
+                                      _mm256_or_si256(eq(hi, ':'), eq(hi, ','))));
+    result.space = _mask(_mm256_or_si256(_mm256_or_si256(eq(lo, ' '), eq(lo, '\t')),
+                                         _mm256_or_si256(eq(lo, '\n'), eq(lo, '\r'))),
+                         _mm256_or_si256(_mm256_or_si256(eq(hi, ' '), eq(hi, '\t')),
+                                         _mm256_or_si256(eq(hi, '\n'), eq(hi, '\r'))));
+    return result;
+}
+#elif defined(__SSE4_2__)
+NODISCARD ALWAYS_INLINE static uint64_t _mask(__m128i v0, __m128i v1, __m128i v2,
+                                              __m128i v3) noexcept {
+    return uint64_t(uint16_t(_mm_movemask_epi8(v0))) |
+           (uint64_t(uint16_t(_mm_movemask_epi8(v1))) << 16) |
+           (uint64_t(uint16_t(_mm_movemask_epi8(v2))) << 32) |
+           (uint64_t(uint16_t(_mm_movemask_epi8(v3))) << 48);
+}
+
+NODISCARD ALWAYS_INLINE static block classify(uint8_t const* p) noexcept {
+    __m128i v[4];
+    __m128i quote[4], backslash[4], op[4], space[4];
+    for (uint32_t i = 0; i < 4u; ++i) {
+        v[i] = _mm_loadu_si128((__m128i const*)(p + i * 16u));
+        auto eq = [&](char c) { return _mm_cmpeq_epi8(v[i], _mm_set1_epi8(c)); };
+        // '[' | 0x20 == '{', ']' | 0x20 == '}'
+        __m128i lower = _mm_or_si128(v[i], _mm_set1_epi8(0x20));
+        quote[i] = eq('"');
+        backslash[i] = eq('\\');
+        op[i] = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')),
+                                          _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+                             _mm_or_si128(eq(':'), eq(',')));
+        space[i] = _mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')));
+    }
+
+    block result;
+    result.quote = _mask(quote[0], quote[1], quote[2], quote[3]);
+    result.backslash = _mask(backslash[0], backslash[1], backslash[2], backslash[3]);
+    result.op = _mask(op[0], op[1], op[2], op[3]);
+    result.space = _mask(space[0], space[1], space[2], space[3]);
+    return result;
+}
+#else
+NODISCARD ALWAYS_INLINE static block classify(uint8_t const* p) noexcept {
+    block result{0u, 0u, 0u, 0u};
+    for (uint32_t i = 0; i < block_size; ++i) {
+        uint64_t bit = 1ULL << i;
+        switch (p[i]) {
+            case '"':
+                result.quote |= bit;
+                break;
+            case '\\':
+                result.backslash |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                result.op |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                result.space |= bit;
+                break;
+            default:;
+        }
+    }
+    return result;
+}
+#endif
+
+/* 第一阶段: 每次处理 64 字节, 输出结构字符(字符串外的 {}[]:, 、引号以及标量起始)的位图 */
+class scanner final : public object {
+protected:
+    uint64_t _escaped{0u};
+    uint64_t _string{0u};
+    uint64_t _scalar{0u};
+
+    NODISCARD ALWAYS_INLINE uint64_t _next_escaped(uint64_t backslash) noexcept {
+        if (likely(backslash == 0u)) {
+            uint64_t escaped = _escaped;
+            _escaped = 0u;
+            return escaped;
+        }
+        constexpr uint64_t even_bits = 0x5555555555555555ULL;
+        backslash &= ~_escaped;
+        uint64_t follows_escape = (backslash << 1) | _escaped;
+        uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+        uint64_t even_starts;
+        _escaped = __builtin_add_overflow(odd_starts, backslash, &even_starts) ? 1u : 0u;
+        return (even_bits ^ (even_starts << 1)) & follows_escape;
+    }
+
+public:
+    /* 返回值: 结构字符位图; string: 字符串内(含起始引号)的字节位图;
+     * escaped: 被反斜杠转义的字节位图 */
+    NODISCARD ALWAYS_INLINE uint64_t next(uint8_t const* p,
+                                          uint64_t* string = nullptr,
+                                          uint64_t* escaped = nullptr) noexcept {
+        auto block = classify(p);
+        uint64_t escape = _next_escaped(block.backslash);
+        uint64_t quote = block.quote & ~escape;
+        uint64_t in_string = prefix_xor(quote) ^ _string;
+        _string = uint64_t(int64_t(in_string) >> 63);
+        uint64_t scalar = ~(block.op | block.space | quote | in_string);
+        uint64_t scalar_start = scalar & ~((scalar << 1) | _scalar);
+        _scalar = scalar >> 63;
+        if (string != nullptr) {
+            *string = in_string;
+        }
+        if (escaped != nullptr) {
+            *escaped = escape;
+        }
+        return (block.op & ~in_string) | quote | scalar_start;
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t in_string() const noexcept { return _string != 0u; }
+};
+
+/* 控制字符(小于 0x20)的位图 */
+NODISCARD ALWAYS_INLINE static uint64_t control(uint8_t const* p) noexcept {
+#if defined(__AVX2__)
+    uint64_t result{0u};
+    for (uint32_t i = 0; i < 2u; ++i) {
+        __m256i v = _mm256_loadu_si256((__m256i const*)(p + i * 32u));
+        // min(v, 0x1f) == v 即 v <= 0x1f
+        __m256i below = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1f)), v);
+        result |= uint64_t(uint32_t(_mm256_movemask_epi8(below))) << (i * 32u);
+    }
+    return result;
+#elif defined(__SSE2__)
+    uint64_t result{0u};
+    for (uint32_t i = 0; i < 4u; ++i) {
+        __m128i v = _mm_loadu_si128((__m128i const*)(p + i * 16u));
+        __m128i below = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1f)), v);
+        result |= uint64_t(uint16_t(_mm_movemask_epi8(below))) << (i * 16u);
+    }
+    return result;
+#else
+    uint64_t result{0u};
+    for (uint32_t i = 0; i < block_size; ++i) {
+        if (p[i] < 0x20u) {
+            result |= 1ULL << i;
+        }
+    }
+    return result;
+#endif
+}
+
+/* 返回 [first, last) 中第一个需要转义的字符('"', '\\' 与控制字符)的偏移 */
+NODISCARD ALWAYS_INLINE static size_t escape_prefix(uint8_t const* first,
+                                                    uint8_t const* last) noexcept {
+    auto p = first;
+#if defined(__AVX2__)
+    for (; p + 32 <= last; p += 32) {
+        __m256i v = _mm256_loadu_si256((__m256i const*)(p));
+        // v <= 0x1F
+        __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v);
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+        uint32_t mask = uint32_t(_mm256_movemask_epi8(_mm256_or_si256(special, control)));
+        if (mask != 0u) {
+            return size_t(p - first) + __builtin_ctz(mask);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; p + 16 <= last; p += 16) {
+        __m128i v = _mm_loadu_si128((__m128i const*)(p));
+        __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v);
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                       _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+        uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_or_si128(special, control)));
+        if (mask != 0u) {
+            return size_t(p - first) + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; p < last; ++p) {
+        if (*p == '"' || *p == '\\' || *p < 0x20u) {
+            break;
+        }
+    }
+    return size_t(p - first);
+}
+
+/* 返回 [first, last) 中第一个引号或括号 '"', '{', '}', '[', ']' 的偏移, 用于跳过子树 */
+NODISCARD ALWAYS_INLINE static size_t bracket_prefix(uint8_t const* first,
+                                                     uint8_t const* last) noexcept {
+    auto p = first;
+#if defined(__AVX2__)
+    for (; p + 32 <= last; p += 32) {
+        __m256i v = _mm256_loadu_si256((__m256i const*)(p));
+        // '[' | 0x20 == '{', ']' | 0x20 == '}'
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i bracket = _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')),
+                                          _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}')));
+        __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+        uint32_t mask = uint32_t(_mm256_movemask_epi8(_mm256_or_si256(bracket, quote)));
+        if (mask != 0u) {
+            return size_t(p - first) + __builtin_ctz(mask);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; p + 16 <= last; p += 16) {
+        __m128i v = _mm_loadu_si128((__m128i const*)(p));
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i bracket = _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')),
+                                       _mm_cmpeq_epi8(lower, _mm_set1_epi8('}')));
+        __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+        uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_or_si128(bracket, quote)));
+        if (mask != 0u) {
+            return size_t(p - first) + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; p < last; ++p) {
+        if (*p == '"' || (*p | 0x20u) == '{' || (*p | 0x20u) == '}') {
+            break;
+        }
+    }
+    return size_t(p - first);
+}
+
+};  // namespace simd
+
+template <class Char>
+NODISCARD ALWAYS_INLINE enable_if_t<sizeof(Char) == 1u, size_t> __escape_prefix(
+    Char const* first, Char const* last) noexcept {
+    return simd::escape_prefix((uint8_t const*)(first), (uint8_t const*)(last));
+}
+
+template <class Char>
+NODISCARD ALWAYS_INLINE enable_if_t<sizeof(Char) != 1u, size_t> __escape_prefix(
+    Char const* first, Char const* last) noexcept {
+    auto p = first;
+    while (p < last && *p != '"' && *p != '\\' && !(*p >= 0 && *p < 0x20)) {
+        ++p;
+    }
+    return size_t(p - first);
+}
+
+template <class Char>
+NODISCARD ALWAYS_INLINE enable_if_t<sizeof(Char) == 1u, size_t> __bracket_prefix(
+    Char const* first, Char const* last) noexcept {
+    return simd::bracket_prefix((uint8_t const*)(first), (uint8_t const*)(last));
+}
+
+template <class Char>
+NODISCARD ALWAYS_INLINE enable_if_t<sizeof(Char) != 1u, size_t> __bracket_prefix(
+    Char const* first, Char const* last) noexcept {
+    auto p = first;
+    while (p < last && *p != '"' && *p != '{' && *p != '}' && *p != '[' && *p != ']') {
+        ++p;
+    }
+    return size_t(p - first);
+}
+
+/* 把一个需要转义的字符写成转义序列, 返回长度 */
+template <class Char>
+ALWAYS_INLINE size_t __escape_sequence(Char c, Char (&s)[6]) noexcept {
+    constexpr char hex[] = "0123456789abcdef";
+    s[0] = '\\';
+    s[1] = c;
+    switch (c) {
+        case '"':
+        case '\\':
+            return 2u;
+        case '\b':
+            s[1] = 'b';
+            return 2u;
+        case '\f':
+            s[1] = 'f';
+            return 2u;
+        case '\n':
+            s[1] = 'n';
+            return 2u;
+        case '\r':
+            s[1] = 'r';
+            return 2u;
+        case '\t':
+            s[1] = 't';
+            return 2u;
+        default: {
+            s[1] = 'u';
+            s[2] = '0';
+            s[3] = '0';
+            s[4] = hex[(c >> 4) & 0xF];
+            s[5] = hex[c & 0xF];
+            return 6u;
+        }
+    }
+}
+
+/* 把未转义的文本写成 JSON 字符串原文 (不含引号), 与 get<string_t>() 互逆 */
+template <class OutStream, class Char>
+ALWAYS_INLINE OutStream& escape(OutStream& out, string::view<Char> text) {
+    auto first = text.begin();
+    auto last = text.end();
+    while (first < last) {
+        auto n = __escape_prefix(first, last);
+        out << string::view<Char>(first, first + n);
+        first += n;
+        if (first == last) {
+            break;
+        }
+        Char s[6]{};
+        out << string::view<Char>(s, s + __escape_sequence(*first++, s));
+    }
+    return out;
+}
+
+/* 只统计长度的输出端 */
+template <class Char>
+struct __counting_stream final {
+    size_t size{0u};
+
+    ALWAYS_INLINE __counting_stream& operator<<(string::view<Char> s) noexcept {
+        size += s.size();
+        return *this;
+    }
+};
+
+template <class Char>
+struct __pointer_stream final {
+    Char* p;
+
+    ALWAYS_INLINE __pointer_stream& operator<<(string::view<Char> s) noexcept {
+        p = qlib::copy(s.begin(), s.end(), p);
+        return *this;
+    }
+};
+
+/* 由未转义的文本得到节点中保存的字符串原文. view 策略下无需转义时直接引用 text,
+ * 否则转义结果从 allocator 分配, 生命周期随 allocator, 因此要求 pool_allocator 之类的整体释放的分配器 */
+template <class Text, class Char, class Allocator>
+NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<Text, string::view<Char>>, Text> __escaped_text(
+    string::view<Char> text, Allocator& allocator) {
+    if (likely(__escape_prefix(text.begin(), text.end()) == text.size())) {
+        return text;
+    }
+    static_assert(!is_same_v<Allocator, new_allocator_t>,
+                  "view policy needs an arena allocator (pool_allocator_t) to hold escaped text");
+    __counting_stream<Char> counter;
+    escape(counter, text);
+    auto impl = allocator.template allocate<Char>(counter.size);
+    __pointer_stream<Char> out{impl};
+    escape(out, text);
+    return Text(impl, impl + counter.size);
+}
+
+template <class Text, class Char, class Allocator>
+NODISCARD ALWAYS_INLINE enable_if_t<!is_same_v<Text, string::view<Char>>, Text> __escaped_text(
+    string::view<Char> text, Allocator& allocator) {
+    if (likely(__escape_prefix(text.begin(), text.end()) == text.size())) {
+        return Text(text, allocator);
+    }
+    Text result(typename Text::size_type(text.size() + 16u), allocator);
+    escape(result, text);
+    return result;
+}
+
+/* 二进制格式解码: 由未转义的文本构造字符串节点与键 */
+template <class Json>
+NODISCARD ALWAYS_INLINE Json make_string(string::view<typename Json::char_type> text,
+                                         typename Json::allocator_type& allocator) {
+    return Json(__escaped_text<typename Json::string_type>(text, allocator), allocator);
+}
+
+template <class Json>
+NODISCARD ALWAYS_INLINE typename Json::key_type make_key(
+    string::view<typename Json::char_type> text, typename Json::allocator_type& allocator) {
+    return __escaped_text<typename Json::key_type>(text, allocator);
+}
+
+/* 二进制格式编码: 字符串原文不含转义时直接使用, 否则解码到临时缓冲区 */
+template <class Char, class Func>
+ALWAYS_INLINE void unescape(string::view<Char> text, Func&& func) {
+    if (likely(__backslash_prefix(text.begin(), text.end()) == text.size())) {
+        func(text);
+        return;
+    }
+    auto value = json::value<Char, view>(text).template get<string::value<Char>>();
+    func(string::view<Char>(value.begin(), value.end()));
+}
+
+template <class Allocator = new_allocator_t>
+class structural_index final : public object {
+public:
+    using self = structural_index;
+    using allocator_type = Allocator;
+    using value_type = uint32_t;
+    using size_type = uint32_t;
+    using const_iterator = value_type const*;
+
+protected:
+    vector_t<value_type, Allocator> _impl;
+
+    ALWAYS_INLINE void _flatten(size_type offset, uint64_t bits) {
+        auto size = _impl.size();
+        if (unlikely(size + simd::block_size > _impl.capacity())) {
+            _impl.reserve(_impl.capacity() * 2u + simd::block_size);
+        }
+        auto out = _impl.data() + size;
+        auto count = size_type(__builtin_popcountll(bits));
+        while (bits != 0u) {
+            *out++ = offset + size_type(__builtin_ctzll(bits));
+            bits &= bits - 1u;
+        }
+        _impl.resize(size + count);
+    }
+
+public:
+    ALWAYS_INLINE structural_index() = default;
+    ALWAYS_INLINE explicit structural_index(allocator_type& allocator) : _impl(allocator) {}
+
+    template <class Char>
+    int32_t build(Char const* begin, Char const* end) {
+        static_assert(sizeof(Char) == 1u, "structural index only supports 8-bit characters");
+        /* 偏移为 32 位, 不支持 4 GiB 及以上的输入 */
+        if (unlikely(size_t(end - begin) >= size_t(size_type(-1)))) {
+            return int32_t(error::param_invalid);
+        }
+        auto first = (uint8_t const*)(begin);
+        auto size = size_type(end - begin);
+        _impl.resize(0u);
+        _impl.reserve(size / 8u + simd::block_size);
+
+        simd::scanner scanner;
+        size_type offset{0u};
+        for (; offset + simd::block_size <= size; offset += simd::block_size) {
+            _flatten(offset, scanner.next(first + offset));
+        }
+        if (offset < size) {
+            alignas(32) uint8_t tail[simd::block_size];
+            _memset_(tail, ' ', sizeof(tail));
+            _memcpy_(tail, first + offset, size - offset);
+            _flatten(offset, scanner.next(tail));
+        }
+
+        return scanner.in_string() ? int32_t(error::missing_right_quote) : 0;
+    }
+
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept { return _impl.size(); }
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return _impl.empty(); }
+    NODISCARD ALWAYS_INLINE const_iterator begin() const noexcept { return _impl.begin(); }
+    NODISCARD ALWAYS_INLINE const_iterator end() const noexcept { return _impl.end(); }
+    NODISCARD ALWAYS_INLINE value_type operator[](size_type index) const noexcept {
+        return _impl[index];
+    }
+};
+
+/* 键的驻留表: 相同的键只保存一份, 得到稳定的地址与从 0 开始的编号, 可在多个文档和线程间共享.
+ * 查找无锁; 插入在自旋锁内进行, 扩容后旧的槽数组保留在 pool 中, 并发的读者不会访问到已释放的内存 */
+template <class Char = char>
+class intern_table final : public object {
+public:
+    using self = intern_table;
+    using char_type = Char;
+    using size_type = uint32_t;
+    using string_view_t = string::view<Char>;
+
+    struct entry final {
+        string_view_t text;
+        uint32_t hash;
+        size_type id;
+    };
+
+protected:
+    struct table final {
+        entry const** slots;
+        size_type mask;
+    };
+
+    table* _table{nullptr};
+    size_type _size{0u};
+    bool_t _lock{False};
+    pool_allocator_t _arena;
+
+    NODISCARD ALWAYS_INLINE static uint32_t _hash(string_view_t key) noexcept {
+        return uint32_t(string::hash(key));
+    }
+
+    NODISCARD ALWAYS_INLINE static entry const* _find(table const* impl,
+                                                      string_view_t key,
+                                                      uint32_t hash) noexcept {
+        for (size_type i = hash & impl->mask;; i = (i + 1u) & impl->mask) {
+            auto item = __atomic_load_n(&impl->slots[i], __ATOMIC_ACQUIRE);
+            if (item == nullptr || (item->hash == hash && item->text == key)) {
+                return item;
+            }
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE table* _make(size_type capacity) {
+        auto result = _arena.allocate<table>(1u);
+        result->slots = _arena.allocate<entry const*>(capacity);
+        result->mask = capacity - 1u;
+        for (size_type i = 0u; i < capacity; ++i) {
+            result->slots[i] = nullptr;
+        }
+        return result;
+    }
+
+    ALWAYS_INLINE static void _insert(table* impl, entry const* item) noexcept {
+        auto i = item->hash & impl->mask;
+        while (impl->slots[i] != nullptr) {
+            i = (i + 1u) & impl->mask;
+        }
+        __atomic_store_n(&impl->slots[i], item, __ATOMIC_RELEASE);
+    }
+
+    /* 新表填满后才发布, 读者看到的总是完整的表 */
+    ALWAYS_INLINE void _grow() {
+        auto current = _table;
+        auto next = _make((current->mask + 1u) * 2u);
+        for (size_type i = 0u; i <= current->mask; ++i) {
+            if (current->slots[i] != nullptr) {
+                _insert(next, current->slots[i]);
+            }
+        }
+        __atomic_store_n(&_table, next, __ATOMIC_RELEASE);
+    }
+
+    struct guard final {
+        bool_t* lock;
+
+        ALWAYS_INLINE explicit guard(bool_t* _lock) noexcept : lock(_lock) {
+            while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE)) {
+                while (__atomic_load_n(lock, __ATOMIC_RELAXED)) {
+                }
+            }
+        }
+        ALWAYS_INLINE ~guard() noexcept { __atomic_clear(lock, __ATOMIC_RELEASE); }
+    };
+
+public:
+    ALWAYS_INLINE explicit intern_table(size_type capacity = 64u) {
+        size_type size{16u};
+        while (size < capacity * 2u) {
+            size <<= 1u;
+        }
+        _table = _make(size);
+    }
+
+    intern_table(self const&) = delete;
+    self& operator=(self const&) = delete;
+
+    /* 已驻留的键数, 也是下一个编号 */
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept {
+        return __atomic_load_n(&_size, __ATOMIC_ACQUIRE);
+    }
+
+    NODISCARD ALWAYS_INLINE entry const* find(string_view_t key) const noexcept {
+        return _find(__atomic_load_n(&_table, __ATOMIC_ACQUIRE), key, _hash(key));
+    }
+
+    NODISCARD entry const& intern(string_view_t key) {
+        auto hash = _hash(key);
+        auto item = _find(__atomic_load_n(&_table, __ATOMIC_ACQUIRE), key, hash);
+        if (likely(item != nullptr)) {
+            return *item;
+        }
+
+        guard lock(&_lock);
+        item = _find(_table, key, hash);
+        if (item == nullptr) {
+            if ((_size + 1u) * 2u > _table->mask + 1u) {
+                _grow();
+            }
+            auto text = _arena.allocate<Char>(key.size() + 1u);
+            _memcpy_(text, key.data(), key.size() * sizeof(Char));
+            text[key.size()] = Char(0);
+            auto next = _arena.allocate<entry>(1u);
+            new (next) entry{string_view_t(text, text + key.size()), hash, _size};
+            _insert(_table, next);
+            __atomic_store_n(&_size, _size + 1u, __ATOMIC_RELEASE);
+            item = next;
+        }
+        return *item;
+    }
+};
+
+template <class Json>
+class parser final : public object {
+public:
+    using size_type = size_t;
+    using json_type = Json;
+    using allocator_type = typename Json::allocator_type;
+    using string_type = typename json_type::string_type;
+    using array_type = typename json_type::array_type;
+    using object_type = typename json_type::object_type;
+    using key_type = typename json_type::key_type;
+    using string_t = typename json_type::string_t;
+    using string_view_t = typename json_type::string_view_t;
+    using intern_type = intern_table<typename json_type::char_type>;
+
 protected:
     size_type _capacity{16u};
+    parse_option _options{parse_default};
+    uint32_t const* _sizes{nullptr};
+    intern_type* _intern{nullptr};
 
+    /* 解析期间对象还没有索引, 成员直接位于结点的 storage 中 */
     struct impl {
         bool_t is_object;
         void* _impl{nullptr};
+        json_type* _value{nullptr};
 
-        impl(object_type* object) : is_object{True}, _impl{object} {}
-        impl(array_type* array) : is_object{False}, _impl{array} {}
+        impl(json_type& value)
+                : is_object{value._type == value_enum::object},
+                  _impl{&value._impl},
+                  _value{&value} {}
 
         object_type* object() { return (object_type*)(_impl); }
         array_type* array() { return (array_type*)(_impl); }
+        json_type& value() { return *_value; }
     };
     using impl_type = impl;
 
-    template <class T = key_type>
-    ALWAYS_INLINE static enable_if_t<is_same_v<T, string_view_t>, json_type> create_number_ref(
-        string_view_t value, allocator_type& allocator) {
-        json_type json_value(allocator);
-        json_value._type = value_enum::number_ref;
-        new (&json_value._impl) string_type(value);
-        return json_value;
-    }
+public:
+    using layers_type = vector_t<impl_type>;
 
-    template <class T = key_type>
-    ALWAYS_INLINE static enable_if_t<!is_same_v<T, string_view_t>, json_type> create_number_ref(
-        string_view_t value, allocator_type& allocator) {
+protected:
+
+    ALWAYS_INLINE json_type create_number_ref(string_view_t value, allocator_type& allocator) {
         json_type json_value(allocator);
         json_value._type = value_enum::number_ref;
-        new (&json_value._impl) string_type(value, allocator);
+        json_value._init_number(value, allocator);
+        if (_options & parse_number_cache) {
+            json_value._cache_number();
+        }
         return json_value;
     }
 
@@ -901,7 +2533,8 @@ protected:
     ALWAYS_INLINE enable_if_t<is_same_v<T, string_view_t>> __object_emplace(impl& layer,
                                                                             string_view_t key,
                                                                             json_type&& value) {
-        layer.object()->emplace_back(key, qlib::move(value));
+        layer.object()->emplace_back(_intern != nullptr ? _intern->intern(key).text : key,
+                                     qlib::move(value));
     }
 
     template <class T = key_type>
@@ -998,11 +2631,11 @@ protected:
             if (*begin == '{') {
                 root._type = value_enum::object;
                 new (&root._impl) object_type(_capacity, allocator);
-                layers.emplace_back(&root.object());
+                layers.emplace_back(root);
             } else if (*begin == '[') {
                 root._type = value_enum::array;
                 new (&root._impl) array_type(_capacity, allocator);
-                layers.emplace_back(&root.array());
+                layers.emplace_back(root);
             } else {
                 result = int32_t(error::missing_left_brace);
                 break;
@@ -1017,6 +2650,7 @@ protected:
                 auto& last_layer = layers.back();
                 if (last_layer.is_object) {
                     if (*begin == '}') {
+                        _close(last_layer);
                         layers.pop_back();
                         ++begin;
                         if (layers.empty()) {
@@ -1043,7 +2677,7 @@ protected:
                             value._type = value_enum::object;
                             new (&value._impl) object_type(_capacity, allocator);
                             __object_emplace(last_layer, key, qlib::move(value));
-                            layers.emplace_back(&last_layer.object()->back().value.object());
+                            layers.emplace_back(last_layer.object()->back().value);
                             ++begin;
                             break;
                         }
@@ -1052,7 +2686,7 @@ protected:
                             value._type = value_enum::array;
                             new (&value._impl) array_type(_capacity, allocator);
                             __object_emplace(last_layer, key, qlib::move(value));
-                            layers.emplace_back(&last_layer.object()->back().value.array());
+                            layers.emplace_back(last_layer.object()->back().value);
                             ++begin;
                             break;
                         }
@@ -1113,7 +2747,7 @@ protected:
                             value._type = value_enum::array;
                             new (&value._impl) array_type(_capacity, allocator);
                             last_layer.array()->emplace_back(qlib::move(value));
-                            layers.emplace_back(&last_layer.array()->back().array());
+                            layers.emplace_back(last_layer.array()->back());
                             ++begin;
                             break;
                         }
@@ -1130,7 +2764,7 @@ protected:
                             value._type = value_enum::object;
                             new (&value._impl) object_type(_capacity, allocator);
                             last_layer.array()->emplace_back(qlib::move(value));
-                            layers.emplace_back(&last_layer.array()->back().object());
+                            layers.emplace_back(last_layer.array()->back());
                             ++begin;
                             continue;
                         }
@@ -1189,27 +2823,4734 @@ protected:
         return result;
     }
 
-public:
-    constexpr parser() noexcept = default;
+    ALWAYS_INLINE void _close(impl& layer) {
+        if ((_options & parse_hash_index) && layer.is_object &&
+            layer.object()->size() >= json_type::hash_threshold) {
+            layer.value()._build_index();
+        }
+    }
 
-    constexpr parser(size_type capacity) noexcept : _capacity(capacity) {}
+    ALWAYS_INLINE json_type& __emplace(impl& layer, string_view_t key, json_type&& value) {
+        if (layer.is_object) {
+            __object_emplace(layer, key, qlib::move(value));
+            return layer.object()->back().value;
+        }
+        layer.array()->emplace_back(qlib::move(value));
+        return layer.array()->back();
+    }
 
-    template <class Iter1, class Iter2>
-    ALWAYS_INLINE CONSTEXPR int32_t operator()(json_type* json, Iter1 begin, Iter2 end) {
-        vector_t<impl_type> layers(_capacity, json->_allocator());
-        return _call(json, begin, end, layers);
+    template <class Char1>
+    NODISCARD ALWAYS_INLINE static bool_t _is_literal(Char1 const* begin,
+                                                      Char1 const* end,
+                                                      string_view_t literal) {
+        auto stop = begin + literal.size();
+        if (unlikely(stop > end || !equal(literal.begin(), literal.end(), begin))) {
+            return False;
+        }
+        return stop == end || _is_delimiter(*stop);
     }
-};
 
-#if !defined(_cpp17_)
-template <class Json>
-typename parser<Json>::char_helper parser<Json>::_char_helper{};
-#endif
+    NODISCARD ALWAYS_INLINE static bool_t _is_delimiter(uint8_t c) {
+        auto type = _char_helper[c];
+        return type >= char_helper::type::skip && type <= char_helper::type::right_bracket;
+    }
 
-template <class Iter1, class Iter2, class Json>
-ALWAYS_INLINE CONSTEXPR int32_t parse(Json* json, Iter1 begin, Iter2 end) noexcept {
-    parser<Json> parser;
-    return parser(json, begin, end);
+    /* 预扫描: 按容器在输入中出现的顺序统计直接子结点数, 建树时每个容器一次分配到位.
+     * 只是容量提示, 输入非法时由第二阶段报错 */
+    template <class Char1, class IndexAllocator>
+    static void _count_sizes(Char1 const* begin,
+                             structural_index<IndexAllocator> const& index,
+                             vector_t<uint32_t>& sizes) {
+        vector_t<uint32_t> opens(64u);
+        sizes.reserve(index.size() / 2u + 1u);
+        auto first = index.begin();
+        for (auto pos = first; pos != index.end(); ++pos) {
+            switch (begin[*pos]) {
+                case '{':
+                case '[': {
+                    opens.emplace_back(uint32_t(pos - first));
+                    opens.emplace_back(sizes.size());
+                    sizes.emplace_back(0u);
+                    break;
+                }
+                case ',': {
+                    if (likely(!opens.empty())) {
+                        ++sizes[opens.back()];
+                    }
+                    break;
+                }
+                case '}':
+                case ']': {
+                    if (likely(!opens.empty())) {
+                        auto slot = opens.back();
+                        opens.pop_back();
+                        /* 非空容器的子结点数为逗号数加一 */
+                        if (uint32_t(pos - first) != opens.back() + 1u) {
+                            ++sizes[slot];
+                        }
+                        opens.pop_back();
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE size_type _next_capacity() noexcept {
+        return _sizes != nullptr ? size_type(*_sizes++) : _capacity;
+    }
+
+    /* 第二阶段: 按结构索引建树, 逗号与冒号在这里校验 */
+    template <class Char1, class IndexAllocator>
+    CONSTEXPR int32_t _call(json_type* json,
+                            Char1 const* begin,
+                            Char1 const* end,
+                            structural_index<IndexAllocator> const& index,
+                            vector_t<impl_type>& layers) {
+        int32_t result{0};
+
+        auto pos = index.begin();
+        auto last = index.end();
+        auto& allocator = json->_allocator();
+        json_type root(allocator);
+
+        do {
+            if (unlikely(pos == last)) {
+                result = int32_t(error::missing_left_brace);
+                break;
+            }
+
+            if (begin[*pos] == '{') {
+                root._type = value_enum::object;
+                new (&root._impl) object_type(_next_capacity(), allocator);
+                layers.emplace_back(root);
+            } else if (begin[*pos] == '[') {
+                root._type = value_enum::array;
+                new (&root._impl) array_type(_next_capacity(), allocator);
+                layers.emplace_back(root);
+            } else {
+                result = int32_t(error::missing_left_brace);
+                break;
+            }
+            ++pos;
+
+            bool_t first{True};
+            while (!result) {
+                if (unlikely(pos == last)) {
+                    result = int32_t(error::missing_right_brace);
+                    break;
+                }
+
+                auto& last_layer = layers.back();
+                auto c = begin[*pos];
+                if (c == (last_layer.is_object ? '}' : ']')) {
+                    _close(last_layer);
+                    layers.pop_back();
+                    ++pos;
+                    first = False;
+                    if (layers.empty()) {
+                        result = 1;
+                    }
+                    continue;
+                }
+
+                if (!first) {
+                    if (unlikely(c != ',')) {
+                        result = int32_t(error::missing_comma);
+                        break;
+                    }
+                    if (unlikely(++pos == last)) {
+                        result = int32_t(error::missing_right_brace);
+                        break;
+                    }
+                    c = begin[*pos];
+                }
+
+                string_view_t key;
+                if (last_layer.is_object) {
+                    if (unlikely(c != '"')) {
+                        result = int32_t(error::missing_left_quote);
+                        break;
+                    }
+                    if (unlikely(pos + 1 == last)) {
+                        result = int32_t(error::missing_right_quote);
+                        break;
+                    }
+                    key = string_view_t(begin + pos[0] + 1, begin + pos[1]);
+                    pos += 2;
+                    if (unlikely(pos == last || begin[*pos] != ':')) {
+                        result = int32_t(error::missing_colon);
+                        break;
+                    }
+                    if (unlikely(++pos == last)) {
+                        result = int32_t(error::missing_right_brace);
+                        break;
+                    }
+                    c = begin[*pos];
+                }
+
+                auto p = begin + *pos;
+                switch (c) {
+                    case '"': {
+                        if (unlikely(pos + 1 == last)) {
+                            result = int32_t(error::missing_right_quote);
+                            break;
+                        }
+                        __emplace(last_layer, key,
+                                  json_type(string_view_t(p + 1, begin + pos[1]), allocator));
+                        pos += 2;
+                        break;
+                    }
+                    case '{': {
+                        json_type value(allocator);
+                        value._type = value_enum::object;
+                        new (&value._impl) object_type(_next_capacity(), allocator);
+                        auto& ref = __emplace(last_layer, key, qlib::move(value));
+                        layers.emplace_back(ref);
+                        ++pos;
+                        first = True;
+                        continue;
+                    }
+                    case '[': {
+                        json_type value(allocator);
+                        value._type = value_enum::array;
+                        new (&value._impl) array_type(_next_capacity(), allocator);
+                        auto& ref = __emplace(last_layer, key, qlib::move(value));
+                        layers.emplace_back(ref);
+                        ++pos;
+                        first = True;
+                        continue;
+                    }
+                    case 'n': {
+                        if (likely(_is_literal(p, end, "null"))) {
+                            __emplace(last_layer, key, json_type(allocator));
+                        } else {
+                            result = int32_t(error::invalid_null);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    case 't': {
+                        if (likely(_is_literal(p, end, "true"))) {
+                            __emplace(last_layer, key, json_type(true, allocator));
+                        } else {
+                            result = int32_t(error::invalid_boolean);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    case 'f': {
+                        if (likely(_is_literal(p, end, "false"))) {
+                            __emplace(last_layer, key, json_type(false, allocator));
+                        } else {
+                            result = int32_t(error::invalid_boolean);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    default: {
+                        auto stop = p;
+                        while (stop < end &&
+                               _char_helper[(uint8_t)*stop] == char_helper::type::number) {
+                            ++stop;
+                        }
+                        if (unlikely(stop == p || (stop < end && !_is_delimiter(*stop)))) {
+                            result = int32_t(error::unknown);
+                            break;
+                        }
+                        __emplace(last_layer, key,
+                                  create_number_ref(string_view_t{p, stop}, allocator));
+                        ++pos;
+                    }
+                }
+                first = False;
+            }
+
+            if (result == 1) {
+                *json = qlib::move(root);
+                result = 0;
+            }
+        } while (false);
+
+        return result;
+    }
+
+    template <class Char1, class IndexAllocator>
+    ALWAYS_INLINE CONSTEXPR int32_t _call(json_type* json,
+                                          Char1 const* begin,
+                                          Char1 const* end,
+                                          structural_index<IndexAllocator> const& index,
+                                          layers_type& layers,
+                                          vector_t<uint32_t>& sizes) {
+        if (!(_options & parse_exact_capacity)) {
+            return _call(json, begin, end, index, layers);
+        }
+        sizes.resize(0u);
+        _count_sizes(begin, index, sizes);
+        _sizes = sizes.data();
+        int32_t result = _call(json, begin, end, index, layers);
+        _sizes = nullptr;
+        return result;
+    }
+
+public:
+    constexpr parser() noexcept = default;
+
+    constexpr parser(size_type capacity) noexcept : _capacity(capacity) {}
+
+    constexpr parser(size_type capacity, parse_option options) noexcept
+            : _capacity(capacity), _options(options) {}
+
+    /* 键从 intern 驻留, 只用于 view 策略: copy 策略的键是各自独立的 string_t */
+    constexpr parser(size_type capacity, parse_option options, intern_type* intern) noexcept
+            : _capacity(capacity), _options(options), _intern(intern) {
+        static_assert(is_same_v<key_type, string_view_t>, "interned keys need the view policy");
+    }
+
+    template <class Iter1, class Iter2>
+    ALWAYS_INLINE CONSTEXPR int32_t operator()(json_type* json, Iter1 begin, Iter2 end) {
+        layers_type layers(_capacity, json->_allocator());
+        structural_index<> index;
+        vector_t<uint32_t> sizes;
+        return (*this)(json, begin, end, layers, index, sizes);
+    }
+
+    /* 层级栈, 结构索引与容量表由调用方提供, 重复解析时不再分配, 见 parse_context */
+    template <class Iter1, class Iter2, class IndexAllocator>
+    ALWAYS_INLINE CONSTEXPR int32_t operator()(json_type* json,
+                                               Iter1 begin,
+                                               Iter2 end,
+                                               layers_type& layers,
+                                               structural_index<IndexAllocator>& index,
+                                               vector_t<uint32_t>& sizes) {
+        /* 结构字符都是 ASCII, 整个输入合法即所有字符串合法 */
+        if ((_options & parse_validate_utf8) && sizeof(typename json_type::char_type) == 1u) {
+            auto first = (uint8_t const*)(&*begin);
+            if (unlikely(!simd::validate_utf8(first, first + (end - begin)))) {
+                return int32_t(error::invalid_utf8);
+            }
+        }
+        layers.clear();
+        if (_options & (parse_two_stage | parse_exact_capacity)) {
+            if (unlikely(!(begin < end))) {
+                return int32_t(error::missing_left_brace);
+            }
+            auto first = &*begin;
+            auto last = first + (end - begin);
+            int32_t result = index.build(first, last);
+            return result != 0 ? result : _call(json, first, last, index, layers, sizes);
+        }
+        return _call(json, begin, end, layers);
+    }
+
+    template <class Char1, class IndexAllocator>
+    ALWAYS_INLINE CONSTEXPR int32_t operator()(json_type* json,
+                                               Char1 const* begin,
+                                               Char1 const* end,
+                                               structural_index<IndexAllocator> const& index) {
+        layers_type layers(_capacity, json->_allocator());
+        vector_t<uint32_t> sizes;
+        return _call(json, begin, end, index, layers, sizes);
+    }
+};
+
+#if !defined(_cpp17_)
+template <class Json>
+typename parser<Json>::char_helper parser<Json>::_char_helper{};
+#endif
+
+template <class Iter1, class Iter2, class Json>
+ALWAYS_INLINE CONSTEXPR int32_t parse(Json* json, Iter1 begin, Iter2 end) noexcept {
+    parser<Json> parser;
+    return parser(json, begin, end);
+}
+
+template <class Iter1, class Iter2, class Json>
+ALWAYS_INLINE CONSTEXPR int32_t parse(Json* json,
+                                      Iter1 begin,
+                                      Iter2 end,
+                                      parse_option options) noexcept {
+    parser<Json> parser(16u, options);
+    return parser(json, begin, end);
+}
+
+/* 结果中的键指向 table 而不是输入, 相同的键在所有文档中地址相同; table 须比文档存活更久 */
+template <class Iter1, class Iter2, class Json>
+ALWAYS_INLINE CONSTEXPR int32_t parse(Json* json,
+                                      Iter1 begin,
+                                      Iter2 end,
+                                      parse_option options,
+                                      intern_table<typename Json::char_type>& table) noexcept {
+    parser<Json> parser(16u, options, &table);
+    return parser(json, begin, end);
+}
+
+/* 解析上下文: 持有分配器, 层级栈, 结构索引与文档, 逐个解析文档时复用全部内存.
+ * 每次 parse 前整体回收上一个文档, 因此上一个文档(及其中的引用)在下一次 parse 后失效 */
+template <class Json>
+class parse_context final : public object {
+public:
+    using self = parse_context;
+    using json_type = Json;
+    using allocator_type = typename json_type::allocator_type;
+    using parser_type = parser<json_type>;
+    using size_type = size_t;
+
+    static_assert(!is_same_v<allocator_type, new_allocator_t>,
+                  "parse_context needs a resettable arena allocator (pool_allocator_t)");
+
+    /* 高水位统计, 用于确定分配器与缓冲区的初始容量. bytes 为最近一个文档占用的字节数,
+     * capacity 为分配器保留的字节数, peak_structurals 只在 two_stage/exact_capacity 下统计 */
+    struct statistics final {
+        size_type documents{0u};
+        size_type bytes{0u};
+        size_type peak_bytes{0u};
+        size_type capacity{0u};
+        size_type layer_capacity{0u};
+        size_type peak_structurals{0u};
+    };
+
+protected:
+    allocator_type _allocator;
+    parser_type _parser;
+    typename parser_type::layers_type _layers;
+    structural_index<> _index;
+    vector_t<uint32_t> _sizes;
+    json_type _json;
+    statistics _statistics{};
+
+public:
+    template <class... Args>
+    ALWAYS_INLINE explicit parse_context(parse_option options = parse_default, Args&&... args)
+            : _allocator(qlib::forward<Args>(args)...), _parser(16u, options), _layers(16u),
+              _json(_allocator) {}
+
+    parse_context(self const&) = delete;
+    self& operator=(self const&) = delete;
+
+    template <class Iter1, class Iter2>
+    int32_t parse(Iter1 begin, Iter2 end) {
+        /* 文档的内存全部来自分配器, 无需逐个析构结点 */
+        new (&_json) json_type(_allocator);
+        _allocator.reset();
+        auto result = _parser(&_json, begin, end, _layers, _index, _sizes);
+
+        auto& stats = _statistics;
+        ++stats.documents;
+        stats.bytes = _allocator.used();
+        stats.peak_bytes = stats.bytes > stats.peak_bytes ? stats.bytes : stats.peak_bytes;
+        stats.capacity = _allocator.capacity();
+        stats.layer_capacity = _layers.capacity();
+        stats.peak_structurals =
+            _index.size() > stats.peak_structurals ? _index.size() : stats.peak_structurals;
+        return result;
+    }
+
+    NODISCARD ALWAYS_INLINE json_type& document() noexcept { return _json; }
+    NODISCARD ALWAYS_INLINE json_type const& document() const noexcept { return _json; }
+    NODISCARD ALWAYS_INLINE statistics const& stats() const noexcept { return _statistics; }
+    NODISCARD ALWAYS_INLINE allocator_type& allocator() noexcept { return _allocator; }
+};
+
+#if defined(QLIB_FILE_HPP)
+/* 直接解析映射的文件, view 策略的结果引用映射内存; 需要选项时使用 file.begin()/file.end() */
+template <class Json>
+ALWAYS_INLINE int32_t parse(Json* json, mapped_file const& file) {
+    return parse(json, file.begin(), file.end());
+}
+#endif
+
+/* 推送式解析: 输入可任意分块, 层级栈与跨块的不完整 token 保留到下一次 feed, 根结点闭合即交付 */
+template <class Json>
+class stream_parser final : public object {
+public:
+    using self = stream_parser;
+    using size_type = size_t;
+    using json_type = Json;
+    using char_type = typename json_type::char_type;
+    using allocator_type = typename json_type::allocator_type;
+    using array_type = typename json_type::array_type;
+    using object_type = typename json_type::object_type;
+    using string_t = typename json_type::string_t;
+    using string_view_t = typename json_type::string_view_t;
+    using buffer_type = string::value<char_type>;
+
+    /* view 策略的值引用输入缓冲区, 分块输入在 feed 返回后即失效 */
+    static_assert(!is_same_v<typename json_type::string_type, string_view_t>,
+                  "stream_parser requires json::copy");
+
+protected:
+    enum class token : uint8_t { none, string, number, literal };
+
+    struct layer final {
+        bool_t is_object;
+        void* _impl{nullptr};
+        json_type* _value{nullptr};
+
+        layer(json_type& value)
+                : is_object{value._type == value_enum::object},
+                  _impl{&value._impl},
+                  _value{&value} {}
+
+        object_type* object() { return (object_type*)(_impl); }
+        array_type* array() { return (array_type*)(_impl); }
+        json_type& value() { return *_value; }
+    };
+
+    size_type _capacity{16u};
+    parse_option _options{parse_default};
+    json_type _root;
+    vector_t<layer> _layers;
+    buffer_type _key;
+    buffer_type _partial;
+    token _token{token::none};
+    bool_t _has_key{False};
+    bool_t _escaped{False};
+    int32_t _error{0};
+
+    NODISCARD ALWAYS_INLINE allocator_type& _allocator() noexcept { return _root._allocator(); }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_skip(char_type c) noexcept {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ':';
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_delimiter(char_type c) noexcept {
+        return _is_skip(c) || c == '{' || c == '}' || c == '[' || c == ']' || c == '"';
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_number(char_type c) noexcept {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' ||
+               c == 'E';
+    }
+
+    /* 返回闭合引号的位置, 未找到时返回 end 并记录末尾是否处于转义中 */
+    NODISCARD ALWAYS_INLINE char_type const* _string_end(char_type const* p,
+                                                         char_type const* end) noexcept {
+        for (; p < end; ++p) {
+            if (_escaped) {
+                _escaped = False;
+            } else if (*p == '\\') {
+                _escaped = True;
+            } else if (*p == '"') {
+                return p;
+            }
+        }
+        return end;
+    }
+
+    NODISCARD ALWAYS_INLINE static char_type const* _scalar_end(char_type const* p,
+                                                                char_type const* end) noexcept {
+        while (p < end && !_is_delimiter(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    ALWAYS_INLINE void _emplace(json_type&& value) {
+        auto& last = _layers.back();
+        if (last.is_object) {
+            string_view_t key(_key.begin(), _key.end());
+            last.object()->emplace_back(string_t(key, _allocator()), qlib::move(value));
+            _has_key = False;
+        } else {
+            last.array()->emplace_back(qlib::move(value));
+        }
+    }
+
+    ALWAYS_INLINE void _open(bool_t is_object) {
+        auto& allocator = _allocator();
+        json_type value(allocator);
+        if (is_object) {
+            value._type = value_enum::object;
+            new (&value._impl) object_type(_capacity, allocator);
+        } else {
+            value._type = value_enum::array;
+            new (&value._impl) array_type(_capacity, allocator);
+        }
+
+        if (_layers.empty()) {
+            _root = qlib::move(value);
+            _layers.emplace_back(_root);
+            return;
+        }
+
+        auto& last = _layers.back();
+        _emplace(qlib::move(value));
+        _layers.emplace_back(last.is_object ? last.object()->back().value : last.array()->back());
+    }
+
+    template <class Func>
+    ALWAYS_INLINE int32_t _close(bool_t is_object, Func& func) {
+        if (unlikely(_layers.empty() || _layers.back().is_object != is_object || _has_key)) {
+            return int32_t(error::missing_right_brace);
+        }
+        auto& last = _layers.back();
+        if ((_options & parse_hash_index) && is_object &&
+            last.object()->size() >= json_type::hash_threshold) {
+            last.value()._build_index();
+        }
+        _layers.pop_back();
+        if (_layers.empty()) {
+            func(_root);
+            _root = json_type(_allocator());
+        }
+        return 0;
+    }
+
+    /* 处理一个完整的标量 token; 对象内的第一个字符串是键 */
+    ALWAYS_INLINE int32_t _scalar(token kind, string_view_t text) {
+        if (unlikely(_layers.empty())) {
+            return int32_t(error::missing_left_brace);
+        }
+        auto& allocator = _allocator();
+        if (_layers.back().is_object && !_has_key) {
+            if (unlikely(kind != token::string)) {
+                return int32_t(error::missing_left_quote);
+            }
+            _key.clear();
+            _key << text;
+            _has_key = True;
+            return 0;
+        }
+
+        switch (kind) {
+            case token::string: {
+                _emplace(json_type(text, allocator));
+                break;
+            }
+            case token::number: {
+                json_type value(allocator);
+                value._type = value_enum::number_ref;
+                value._init_number(text, allocator);
+                if (_options & parse_number_cache) {
+                    value._cache_number();
+                }
+                _emplace(qlib::move(value));
+                break;
+            }
+            default: {
+                if (text == string::true_str<char_type>) {
+                    _emplace(json_type(true, allocator));
+                } else if (text == string::false_str<char_type>) {
+                    _emplace(json_type(false, allocator));
+                } else if (text == string::null_str<char_type>) {
+                    _emplace(json_type(allocator));
+                } else {
+                    return int32_t(*text.begin() == 'n' ? error::invalid_null : error::invalid_boolean);
+                }
+            }
+        }
+        return 0;
+    }
+
+    /* 续接上一块留下的 token, 返回 token 之后的位置 */
+    ALWAYS_INLINE char_type const* _resume(char_type const* p, char_type const* end) {
+        if (_token == token::string) {
+            auto stop = _string_end(p, end);
+            _partial << string_view_t(p, stop);
+            if (stop == end) {
+                return end;
+            }
+            p = stop + 1;
+        } else {
+            auto stop = _scalar_end(p, end);
+            _partial << string_view_t(p, stop);
+            if (stop == end) {
+                return end;
+            }
+            p = stop;
+        }
+        auto kind = _token;
+        _token = token::none;
+        _error = _scalar(kind, string_view_t(_partial.begin(), _partial.end()));
+        _partial.clear();
+        return p;
+    }
+
+public:
+    ALWAYS_INLINE explicit stream_parser(parse_option options = parse_default)
+            : _options(options), _key(64u), _partial(64u) {}
+
+    ALWAYS_INLINE stream_parser(allocator_type& allocator, parse_option options = parse_default)
+            : _options(options), _root(allocator), _key(64u), _partial(64u) {}
+
+    /* 当前没有未完成的文档 */
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept {
+        return _layers.empty() && _token == token::none;
+    }
+
+    ALWAYS_INLINE void reset() {
+        while (!_layers.empty()) {
+            _layers.pop_back();
+        }
+        _root = json_type(_allocator());
+        _partial.clear();
+        _token = token::none;
+        _has_key = False;
+        _escaped = False;
+        _error = 0;
+    }
+
+    /* func(json_type&): 每个闭合的根结点调用一次; 出错后需 reset */
+    template <class Func>
+    int32_t feed(char_type const* begin, char_type const* end, Func&& func) {
+        auto p = begin;
+        if (_error == 0 && _token != token::none) {
+            p = _resume(p, end);
+        }
+
+        while (p < end && _error == 0) {
+            auto c = *p;
+            if (_is_skip(c)) {
+                ++p;
+                continue;
+            }
+
+            switch (c) {
+                case '{':
+                case '[': {
+                    if (unlikely(!_layers.empty() && _layers.back().is_object && !_has_key)) {
+                        _error = int32_t(error::missing_left_quote);
+                        break;
+                    }
+                    _open(c == '{');
+                    ++p;
+                    break;
+                }
+                case '}':
+                case ']': {
+                    _error = _close(c == '}', func);
+                    ++p;
+                    break;
+                }
+                case '"': {
+                    auto stop = _string_end(p + 1, end);
+                    if (stop == end) {
+                        _token = token::string;
+                        _partial << string_view_t(p + 1, end);
+                        p = end;
+                        break;
+                    }
+                    _error = _scalar(token::string, string_view_t(p + 1, stop));
+                    p = stop + 1;
+                    break;
+                }
+                default: {
+                    auto kind = _is_number(c) ? token::number : token::literal;
+                    auto stop = _scalar_end(p, end);
+                    if (stop == end) {
+                        _token = kind;
+                        _partial << string_view_t(p, end);
+                        p = end;
+                        break;
+                    }
+                    _error = _scalar(kind, string_view_t(p, stop));
+                    p = stop;
+                }
+            }
+        }
+        return _error;
+    }
+};
+
+/* 按需访问: 直接在输入缓冲区上遍历, 只解析被访问的值, 未访问的子树按括号匹配跳过 */
+template <class Char>
+class document_view final : public object {
+public:
+    using self = document_view;
+    using char_type = Char;
+    using string_view_t = string::view<Char>;
+    using string_t = string::value<Char>;
+    using size_type = uint32_t;
+
+protected:
+    friend class pointer<Char>;
+    friend class pointer_set<Char>;
+
+    Char const* _begin{nullptr};
+    Char const* _end{nullptr};
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_space(Char c) noexcept {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    NODISCARD ALWAYS_INLINE static Char const* _skip_space(Char const* p, Char const* end) noexcept {
+        while (p < end && _is_space(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    NODISCARD ALWAYS_INLINE static Char const* _skip_string(Char const* p, Char const* end) noexcept {
+        ++p;
+        while (p < end) {
+            p += __escape_prefix(p, end);
+            if (p >= end) {
+                break;
+            }
+            if (*p == '"') {
+                return p + 1;
+            }
+            /* 转义序列或控制字符 */
+            p += (*p == '\\') ? 2 : 1;
+        }
+        return end;
+    }
+
+    NODISCARD static Char const* _skip_value(Char const* p, Char const* end) noexcept {
+        if (unlikely(p >= end)) {
+            return end;
+        }
+        switch (*p) {
+            case '"':
+                return _skip_string(p, end);
+            case '{':
+            case '[': {
+                /* 只需看引号与括号, 其间的字符整段跳过 */
+                uint32_t depth{0u};
+                do {
+                    p += __bracket_prefix(p, end);
+                    if (p >= end) {
+                        break;
+                    }
+                    switch (*p) {
+                        case '"':
+                            p = _skip_string(p, end);
+                            continue;
+                        case '{':
+                        case '[':
+                            ++depth;
+                            break;
+                        default:
+                            --depth;
+                    }
+                    ++p;
+                } while (p < end && depth != 0u);
+                return p;
+            }
+            default: {
+                while (p < end && !_is_space(*p) && *p != ',' && *p != ']' && *p != '}') {
+                    ++p;
+                }
+                return p;
+            }
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE static self _make(Char const* begin, Char const* end) noexcept {
+        self result;
+        result._begin = begin;
+        result._end = end;
+        return result;
+    }
+
+public:
+    struct member final {
+        string_view_t key;
+        self value;
+    };
+
+    class iterator final : public object {
+    protected:
+        Char const* _cur{nullptr};
+        Char const* _end{nullptr};
+        bool_t _is_object{False};
+        member _member{};
+
+        ALWAYS_INLINE void _load() noexcept {
+            if (_cur >= _end || *_cur == (_is_object ? '}' : ']')) {
+                _cur = _end;
+                return;
+            }
+            auto p = _cur;
+            if (_is_object) {
+                auto key_end = _skip_string(p, _end);
+                _member.key = string_view_t(p + 1, key_end - 1);
+                p = _skip_space(key_end, _end);
+                p = _skip_space(p + 1, _end);  // 跳过 ':'
+            }
+            _member.value = _make(p, _skip_value(p, _end));
+        }
+
+    public:
+        ALWAYS_INLINE iterator() = default;
+
+        ALWAYS_INLINE iterator(Char const* cur, Char const* end, bool_t is_object) noexcept
+                : _cur(cur), _end(end), _is_object(is_object) {
+            _load();
+        }
+
+        NODISCARD ALWAYS_INLINE member const& operator*() const noexcept { return _member; }
+        NODISCARD ALWAYS_INLINE member const* operator->() const noexcept { return &_member; }
+
+        ALWAYS_INLINE iterator& operator++() noexcept {
+            auto p = _skip_space(_member.value._end, _end);
+            _cur = (p < _end && *p == ',') ? _skip_space(p + 1, _end) : _end;
+            _load();
+            return *this;
+        }
+
+        NODISCARD ALWAYS_INLINE bool_t operator==(iterator const& o) const noexcept {
+            return _cur == o._cur;
+        }
+        NODISCARD ALWAYS_INLINE bool_t operator!=(iterator const& o) const noexcept {
+            return _cur != o._cur;
+        }
+    };
+
+    ALWAYS_INLINE document_view() = default;
+
+    ALWAYS_INLINE document_view(Char const* begin, Char const* end) noexcept {
+        _begin = _skip_space(begin, end);
+        _end = _skip_value(_begin, end);
+    }
+
+    ALWAYS_INLINE explicit document_view(string_view_t text) noexcept
+            : document_view(text.begin(), text.end()) {}
+
+    NODISCARD ALWAYS_INLINE value_enum type() const noexcept {
+        if (unlikely(_begin == _end)) {
+            return value_enum::null;
+        }
+        switch (*_begin) {
+            case '{':
+                return value_enum::object;
+            case '[':
+                return value_enum::array;
+            case '"':
+                return value_enum::string;
+            case 't':
+            case 'f':
+                return value_enum::boolean;
+            case 'n':
+                return value_enum::null;
+            default:
+                return value_enum::number_ref;
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return type() == value_enum::null; }
+    NODISCARD ALWAYS_INLINE explicit operator bool_t() const noexcept { return !empty(); }
+
+    NODISCARD ALWAYS_INLINE string_view_t raw() const noexcept {
+        return string_view_t(_begin, _end);
+    }
+
+    NODISCARD ALWAYS_INLINE iterator begin() const noexcept {
+        auto type = this->type();
+        if (type != value_enum::object && type != value_enum::array) {
+            return end();
+        }
+        return iterator(_skip_space(_begin + 1, _end), _end, type == value_enum::object);
+    }
+
+    NODISCARD ALWAYS_INLINE iterator end() const noexcept { return iterator(_end, _end, False); }
+
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept {
+        size_type size{0u};
+        for (auto it = begin(); it != end(); ++it) {
+            ++size;
+        }
+        return size;
+    }
+
+    NODISCARD ALWAYS_INLINE self operator[](string_view_t key) const {
+        throw_if(type() != value_enum::object, "not object");
+        for (auto it = begin(); it != end(); ++it) {
+            if (it->key == key) {
+                return it->value;
+            }
+        }
+        return self{};
+    }
+
+    NODISCARD ALWAYS_INLINE self at(size_type index) const {
+        throw_if(type() != value_enum::array, "not array");
+        for (auto it = begin(); it != end(); ++it, --index) {
+            if (index == 0u) {
+                return it->value;
+            }
+        }
+        return self{};
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_number_v<T>, T> get() const {
+        throw_if(type() != value_enum::number_ref, "not number");
+        T value{};
+        converter<T>::decode(value, _begin, _end);
+        return value;
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, bool_t>, T> get() const {
+        throw_if(type() != value_enum::boolean, "not boolean");
+        auto text = raw();
+        if (text == string::true_str<char_type>) {
+            return True;
+        } else if (text == string::false_str<char_type>) {
+            return False;
+        } else {
+            __throw("not boolean");
+        }
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_view_t>, T> get() const {
+        throw_if(type() != value_enum::string, "not str");
+        return string_view_t(_begin + 1, _end - 1);
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_t>, T> get() const {
+        return value<Char, view>(get<string_view_t>()).template get<string_t>();
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE T get(T&& default_value) const {
+        if (empty()) {
+            return qlib::forward<T>(default_value);
+        }
+        return get<T>();
+    }
+
+    /* 物化为 json::value, 例如 json_view_t */
+    template <class Json>
+    int32_t parse(Json* json) const {
+        int32_t result{0};
+        auto& allocator = json->_allocator();
+        switch (type()) {
+            case value_enum::object:
+            case value_enum::array: {
+                parser<Json> parser;
+                result = parser(json, _begin, _end);
+                break;
+            }
+            case value_enum::string: {
+                *json = Json(get<string_view_t>(), allocator);
+                break;
+            }
+            case value_enum::boolean: {
+                *json = Json(get<bool_t>(), allocator);
+                break;
+            }
+            case value_enum::number_ref: {
+                Json value(allocator);
+                value._type = value_enum::number_ref;
+                value._init_number(raw(), allocator);
+                *json = qlib::move(value);
+                break;
+            }
+            default: {
+                *json = Json(allocator);
+            }
+        }
+        return result;
+    }
+};
+
+/* RFC 6901 JSON Pointer, 例如 "/configurePresets/0/cacheVariables".
+ * 构造时切分路径, 每段保存转义后的键(与节点中保存的键同一形式)与哈希, 以及数组下标,
+ * 之后可以反复对 json::value 或未解析的文本求值. 键按原文比较, 与 value::operator[] 相同 */
+template <class Char>
+class pointer final : public object {
+public:
+    using self = pointer;
+    using char_type = Char;
+    using string_view_t = string::view<Char>;
+    using string_t = string::value<Char>;
+    using size_type = uint32_t;
+    static constexpr size_type npos = size_type(-1);
+
+protected:
+    friend class pointer_set<Char>;
+    friend class frozen<Char>;
+    template <class>
+    friend class patcher;
+
+    struct token final {
+        size_type begin;
+        size_type end;
+        uint32_t hash;
+        size_type index;
+    };
+
+    string_t _keys;
+    vector_t<token> _tokens;
+
+    /* 不带前导零的十进制数才是数组下标 */
+    NODISCARD ALWAYS_INLINE static size_type _index(string_view_t key) noexcept {
+        if (key.empty() || key.size() > 9u || (key.size() > 1u && key[0u] == '0')) {
+            return npos;
+        }
+        size_type index{0u};
+        for (auto c : key) {
+            if (c < '0' || c > '9') {
+                return npos;
+            }
+            index = index * 10u + size_type(c - '0');
+        }
+        return index;
+    }
+
+    ALWAYS_INLINE void _push(string_t const& key) {
+        auto begin = size_type(_keys.size());
+        escape(_keys, string_view_t(key.begin(), key.end()));
+        auto end = size_type(_keys.size());
+        auto text = string_view_t(_keys.begin() + begin, _keys.begin() + end);
+        /* 与 hash_index 的哈希相同 */
+        _tokens.emplace_back(token{begin, end, uint32_t(string::hash(text)), _index(text)});
+    }
+
+    NODISCARD ALWAYS_INLINE string_view_t _key(token const& token) const noexcept {
+        return string_view_t(_keys.begin() + token.begin, _keys.begin() + token.end);
+    }
+
+    using view_type = document_view<Char>;
+
+    /* 在原文中找到对象的成员或数组的元素, 返回值的起始, 找不到返回 nullptr */
+    NODISCARD Char const* _child(token const& token,
+                                 Char const* p,
+                                 Char const* end) const noexcept {
+        if (*p == '{') {
+            auto key = _key(token);
+            p = view_type::_skip_space(p + 1, end);
+            while (p < end && *p == '"') {
+                auto key_end = view_type::_skip_string(p, end);
+                auto value = view_type::_skip_space(view_type::_skip_space(key_end, end) + 1, end);
+                if (string_view_t(p + 1, key_end - 1) == key) {
+                    return value;
+                }
+                p = view_type::_skip_space(view_type::_skip_value(value, end), end);
+                if (p >= end || *p != ',') {
+                    break;
+                }
+                p = view_type::_skip_space(p + 1, end);
+            }
+        } else if (*p == '[' && token.index != npos) {
+            p = view_type::_skip_space(p + 1, end);
+            for (size_type i = 0u; p < end && *p != ']'; ++i) {
+                if (i == token.index) {
+                    return p;
+                }
+                p = view_type::_skip_space(view_type::_skip_value(p, end), end);
+                if (p >= end || *p != ',') {
+                    break;
+                }
+                p = view_type::_skip_space(p + 1, end);
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    ALWAYS_INLINE pointer() = default;
+
+    /* "" 表示整个文档; 每段以 '/' 开始, "~1" 表示 '/', "~0" 表示 '~' */
+    explicit pointer(string_view_t path) {
+        throw_if(!path.empty() && path[0u] != '/', "invalid pointer");
+        auto p = path.begin();
+        auto last = path.end();
+        string_t key;
+        while (p < last) {
+            ++p;
+            key.clear();
+            for (; p < last && *p != '/'; ++p) {
+                if (*p != '~') {
+                    key << *p;
+                    continue;
+                }
+                throw_if(p + 1 == last || (p[1] != '0' && p[1] != '1'), "invalid pointer");
+                key << (*++p == '0' ? Char('~') : Char('/'));
+            }
+            _push(key);
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept { return _tokens.size(); }
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return _tokens.empty(); }
+
+    /* 第 i 段的键, 转义后的形式 */
+    NODISCARD ALWAYS_INLINE string_view_t operator[](size_type i) const noexcept {
+        return _key(_tokens[i]);
+    }
+
+    /* 对 json::value 求值, 对象使用已有的哈希索引; 找不到返回 nullptr, 不抛出异常 */
+    template <class Json>
+    NODISCARD Json const* resolve(Json const& json) const noexcept {
+        auto node = &json;
+        for (auto& token : _tokens) {
+            if (node->type() == value_enum::object) {
+                auto pos = node->_find(_key(token), token.hash);
+                if (pos == Json::index_type::npos) {
+                    return nullptr;
+                }
+                node = &node->object()[pos].value;
+            } else if (node->type() == value_enum::array && token.index < node->array().size()) {
+                node = &node->array()[token.index];
+            } else {
+                return nullptr;
+            }
+        }
+        return node;
+    }
+
+    /* 直接对未解析的文本求值: 只跳过不匹配的成员, 不建树也不分配内存; 找不到返回空的 view.
+     * 不校验输入, 需要时先调用 validate */
+    NODISCARD view_type resolve(Char const* begin, Char const* end) const noexcept {
+        auto p = view_type::_skip_space(begin, end);
+        for (auto& token : _tokens) {
+            if (p >= end || (p = _child(token, p, end)) == nullptr) {
+                return view_type{};
+            }
+        }
+        return p < end ? view_type::_make(p, view_type::_skip_value(p, end)) : view_type{};
+    }
+
+    NODISCARD ALWAYS_INLINE view_type resolve(view_type const& view) const noexcept {
+        auto raw = view.raw();
+        return resolve(raw.begin(), raw.end());
+    }
+};
+
+/* 一次扫描文本求出多个 pointer: 路径合并成前缀树, 只进入前缀树中的成员,
+ * 所有路径都找到后立即结束 */
+template <class Char>
+class pointer_set final : public object {
+public:
+    using self = pointer_set;
+    using char_type = Char;
+    using string_view_t = string::view<Char>;
+    using pointer_type = pointer<Char>;
+    using view_type = document_view<Char>;
+    using size_type = uint32_t;
+    static constexpr size_type npos = size_type(-1);
+
+protected:
+    /* 前缀树结点: key 为 _pointers[path] 的第 depth 段; 以该结点结束的路径经 _next 串起来 */
+    struct node final {
+        size_type path;
+        size_type depth;
+        size_type child;
+        size_type sibling;
+        size_type target;
+    };
+
+    vector_t<pointer_type> _pointers;
+    vector_t<node> _nodes;
+    vector_t<size_type> _next;
+
+    NODISCARD ALWAYS_INLINE typename pointer_type::token const& _token(node const& node) const {
+        return _pointers[node.path]._tokens[node.depth];
+    }
+
+    NODISCARD ALWAYS_INLINE size_type _match_key(size_type child, string_view_t key) const {
+        for (; child != npos; child = _nodes[child].sibling) {
+            auto& node = _nodes[child];
+            if (_pointers[node.path]._key(_token(node)) == key) {
+                break;
+            }
+        }
+        return child;
+    }
+
+    NODISCARD ALWAYS_INLINE size_type _match_index(size_type child, size_type index) const {
+        for (; child != npos; child = _nodes[child].sibling) {
+            if (_token(_nodes[child]).index == index) {
+                break;
+            }
+        }
+        return child;
+    }
+
+    /* p 指向值的起始, 返回值的结束; 所有路径都找到后返回 nullptr 提前结束 */
+    Char const* _walk(size_type current,
+                      Char const* p,
+                      Char const* end,
+                      view_type* results,
+                      size_type& remaining) const {
+        if (unlikely(p >= end)) {
+            return end;
+        }
+        auto& node = _nodes[current];
+        Char const* stop;
+        if (node.child == npos || (*p != '{' && *p != '[')) {
+            stop = view_type::_skip_value(p, end);
+        } else {
+            auto is_object = *p == '{';
+            auto q = view_type::_skip_space(p + 1, end);
+            for (size_type i = 0u; q < end && *q != (is_object ? '}' : ']'); ++i) {
+                size_type child;
+                if (is_object) {
+                    auto key_end = view_type::_skip_string(q, end);
+                    child = _match_key(node.child, string_view_t(q + 1, key_end - 1));
+                    q = view_type::_skip_space(view_type::_skip_space(key_end, end) + 1, end);
+                } else {
+                    child = _match_index(node.child, i);
+                }
+                if (child != npos) {
+                    q = _walk(child, q, end, results, remaining);
+                    if (q == nullptr) {
+                        return nullptr;
+                    }
+                } else {
+                    q = view_type::_skip_value(q, end);
+                }
+                q = view_type::_skip_space(q, end);
+                if (q >= end || *q != ',') {
+                    break;
+                }
+                q = view_type::_skip_space(q + 1, end);
+            }
+            stop = q < end ? q + 1 : end;
+        }
+        /* 重复的键会再次走到同一个结点, 只记录第一次出现的值 */
+        for (auto path = node.target; path != npos; path = _next[path]) {
+            if (results[path].raw().empty()) {
+                results[path] = view_type::_make(p, stop);
+                --remaining;
+            }
+        }
+        return remaining == 0u ? nullptr : stop;
+    }
+
+public:
+    ALWAYS_INLINE pointer_set() : _nodes(16u) {
+        _nodes.emplace_back(node{npos, 0u, npos, npos, npos});
+    }
+
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept { return _pointers.size(); }
+
+    NODISCARD ALWAYS_INLINE pointer_type const& operator[](size_type i) const noexcept {
+        return _pointers[i];
+    }
+
+    /* 返回路径的编号, 即 extract 结果中的下标 */
+    size_type add(string_view_t path) {
+        auto id = size_type(_pointers.size());
+        _pointers.emplace_back(path);
+        _next.emplace_back(size_type(npos));
+        auto& pointer = _pointers.back();
+        size_type current{0u};
+        for (size_type depth = 0u; depth < pointer.size(); ++depth) {
+            auto& token = pointer._tokens[depth];
+            auto child = _nodes[current].child;
+            for (; child != npos; child = _nodes[child].sibling) {
+                if (_token(_nodes[child]).index == token.index &&
+                    _pointers[_nodes[child].path]._key(_token(_nodes[child])) ==
+                        pointer._key(token)) {
+                    break;
+                }
+            }
+            if (child == npos) {
+                child = size_type(_nodes.size());
+                _nodes.emplace_back(node{id, depth, npos, _nodes[current].child, npos});
+                _nodes[current].child = child;
+            }
+            current = child;
+        }
+        _next[id] = _nodes[current].target;
+        _nodes[current].target = id;
+        return id;
+    }
+
+    /* results[i] 为第 i 个路径的值, 找不到为空的 view. 不校验输入, 需要时先调用 validate */
+    void extract(Char const* begin, Char const* end, vector_t<view_type>& results) const {
+        results.resize(_pointers.size());
+        for (auto& result : results) {
+            result = view_type{};
+        }
+        auto p = view_type::_skip_space(begin, end);
+        size_type remaining = _pointers.size();
+        if (p < end && remaining != 0u) {
+            _walk(0u, p, end, results.data(), remaining);
+        }
+    }
+};
+
+/* 不可变文档: 每个结点单独分配并带原子引用计数, 拷贝句柄只增加一次计数, 子树可以跨线程共享.
+ * 修改通过 set/erase 返回新文档, 只复制路径上的结点(path copying), 其余子树与原文档共享.
+ * 标量保存转义后的原文, 对象的键也是字符串结点; null 不分配结点.
+ * 与 std::shared_ptr 相同, 同一个句柄不能被多个线程同时赋值 */
+template <class Char>
+class frozen final : public object {
+public:
+    using self = frozen;
+    using char_type = Char;
+    using size_type = uint32_t;
+    using string_view_t = string::view<Char>;
+    using string_t = string::value<Char>;
+    using pointer_type = pointer<Char>;
+
+protected:
+    /* 结点之后紧跟原文 Char[size] 或子结点 node*[size], 对象的子结点按 键, 值 交替存放 */
+    struct node final {
+        size_t refs;
+        size_type size;
+        value_enum type;
+    };
+
+    enum class edit : uint8_t {
+        replace,
+        erase,
+        insert,
+    };
+
+    node* _node{nullptr};
+
+    ALWAYS_INLINE explicit frozen(node* node) noexcept : _node(node) {}
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_container(value_enum type) noexcept {
+        return type == value_enum::object || type == value_enum::array;
+    }
+
+    NODISCARD ALWAYS_INLINE static size_type _count(value_enum type, size_type size) noexcept {
+        return type == value_enum::object ? size * 2u : size;
+    }
+
+    NODISCARD ALWAYS_INLINE static size_t _bytes(value_enum type, size_type size) noexcept {
+        auto count = size_t(_count(type, size));
+        return sizeof(node) + count * (_is_container(type) ? sizeof(node*) : sizeof(Char));
+    }
+
+    NODISCARD ALWAYS_INLINE static node* _make(value_enum type, size_type size) noexcept {
+        auto result = (node*)(new_allocator_t::allocate<uint8_t>(_bytes(type, size)));
+        result->refs = 1u;
+        result->size = size;
+        result->type = type;
+        return result;
+    }
+
+    NODISCARD ALWAYS_INLINE static node* _make(value_enum type, string_view_t text) noexcept {
+        auto result = _make(type, size_type(text.size()));
+        qlib::copy(text.begin(), text.end(), (Char*)(result + 1));
+        return result;
+    }
+
+    NODISCARD ALWAYS_INLINE static node** _children(node const* node) noexcept {
+        return (frozen::node**)(node + 1);
+    }
+
+    NODISCARD ALWAYS_INLINE static string_view_t _text(node const* node) noexcept {
+        auto first = (Char const*)(node + 1);
+        return string_view_t(first, first + node->size);
+    }
+
+    ALWAYS_INLINE static node* _retain(node* node) noexcept {
+        if (node != nullptr) {
+            __atomic_fetch_add(&node->refs, size_t(1u), __ATOMIC_RELAXED);
+        }
+        return node;
+    }
+
+    static void _release(node* node) noexcept {
+        if (node == nullptr) {
+            return;
+        }
+        if (__atomic_sub_fetch(&node->refs, size_t(1u), __ATOMIC_ACQ_REL) != 0u) {
+            return;
+        }
+        if (_is_container(node->type)) {
+            auto children = _children(node);
+            for (size_type i = 0u, count = _count(node->type, node->size); i < count; ++i) {
+                _release(children[i]);
+            }
+        }
+        new_allocator_t::deallocate<uint8_t>((uint8_t*)(node), _bytes(node->type, node->size));
+    }
+
+    /* 二进制数据与文本输出相同, 冻结为字节数组 */
+    template <memory_policy Policy, class Allocator>
+    NODISCARD static node* _freeze(value<Char, Policy, Allocator> const& json) {
+        switch (json.type()) {
+            case value_enum::object: {
+                auto& object = json.object();
+                auto result = _make(value_enum::object, size_type(object.size()));
+                auto children = _children(result);
+                for (auto& item : object) {
+                    auto key = string_view_t(item.key.begin(), item.key.end());
+                    *children++ = _make(value_enum::string, key);
+                    *children++ = _freeze(item.value);
+                }
+                return result;
+            }
+            case value_enum::array: {
+                auto& array = json.array();
+                auto result = _make(value_enum::array, size_type(array.size()));
+                auto children = _children(result);
+                for (auto& item : array) {
+                    *children++ = _freeze(item);
+                }
+                return result;
+            }
+            case value_enum::string:
+                return _make(value_enum::string, json.template get<string_view_t>());
+            case value_enum::number:
+            case value_enum::number_ref:
+                return _make(value_enum::number, json._number_text());
+            case value_enum::boolean:
+                return _make(value_enum::boolean, json.template get<bool_t>()
+                                                      ? string::true_str<Char>
+                                                      : string::false_str<Char>);
+            case value_enum::binary: {
+                auto bytes = json.binary();
+                auto result = _make(value_enum::array, size_type(bytes.size()));
+                auto children = _children(result);
+                for (auto c : bytes) {
+                    Char s[4];
+                    auto last = string::to_chars(s, s + 4, uint8_t(c));
+                    *children++ = _make(value_enum::number, string_view_t(s, last));
+                }
+                return result;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    /* 对象中键的位置, 找不到返回 size */
+    NODISCARD ALWAYS_INLINE static size_type _find(node const* node, string_view_t key) noexcept {
+        auto children = _children(node);
+        size_type i = 0u;
+        for (; i < node->size; ++i) {
+            if (_text(children[2u * i]) == key) {
+                break;
+            }
+        }
+        return i;
+    }
+
+    /* 复制容器结点并在 pos 处修改一个成员, child 为新的值, 对象插入时 key 为新的键;
+     * 其余子结点增加计数后共享 */
+    NODISCARD static node* _copy(node const* from,
+                                 size_type pos,
+                                 edit op,
+                                 node* key,
+                                 node* child) noexcept {
+        auto is_object = from->type == value_enum::object;
+        size_type width = is_object ? 2u : 1u;
+        size_type size = from->size + (op == edit::insert) - (op == edit::erase);
+        auto result = _make(from->type, size);
+        auto source = _children(from);
+        auto target = _children(result);
+        for (size_type i = 0u; i < pos * width; ++i) {
+            *target++ = _retain(source[i]);
+        }
+        if (op != edit::erase) {
+            if (is_object) {
+                *target++ = op == edit::insert ? key : _retain(source[pos * width]);
+            }
+            *target++ = child;
+        }
+        auto total = _count(from->type, from->size);
+        for (auto i = (pos + (op != edit::insert)) * width; i < total; ++i) {
+            *target++ = _retain(source[i]);
+        }
+        return result;
+    }
+
+    /* 沿路径逐层复制, child 的所有权转移给新文档; erase 时 child 忽略 */
+    NODISCARD static node* _update(node const* from,
+                                   pointer_type const& path,
+                                   size_type depth,
+                                   node* child,
+                                   bool_t erase) {
+        auto key = path[depth];
+        auto last = depth + 1u == path.size();
+        auto op = erase && last ? edit::erase : edit::replace;
+        throw_if(from == nullptr || !_is_container(from->type), "path not found");
+        if (from->type == value_enum::object) {
+            auto pos = _find(from, key);
+            if (pos == from->size) {
+                throw_if(!last || erase, "path not found");
+                return _copy(from, pos, edit::insert, _make(value_enum::string, key), child);
+            }
+            if (!last) {
+                child = _update(_children(from)[2u * pos + 1u], path, depth + 1u, child, erase);
+            }
+            return _copy(from, pos, op, nullptr, child);
+        }
+        auto pos = key == string_view_t("-") ? from->size : pointer_type::_index(key);
+        throw_if(pos > from->size || (pos == from->size && (!last || erase)), "path not found");
+        if (pos == from->size) {
+            return _copy(from, pos, edit::insert, nullptr, child);
+        }
+        if (!last) {
+            child = _update(_children(from)[pos], path, depth + 1u, child, erase);
+        }
+        return _copy(from, pos, op, nullptr, child);
+    }
+
+    template <class OutStream>
+    static void _to(OutStream& out, node const* node) {
+        constexpr string_view_t quote_str{"\""};
+        constexpr string_view_t comma_str{","};
+        constexpr string_view_t colon_str{":"};
+
+        switch (node != nullptr ? node->type : value_enum::null) {
+            case value_enum::object: {
+                out << string_view_t{"{"};
+                auto children = _children(node);
+                for (size_type i = 0u; i < node->size; ++i) {
+                    if (i != 0u) {
+                        out << comma_str;
+                    }
+                    out << quote_str << _text(children[2u * i]) << quote_str << colon_str;
+                    _to(out, children[2u * i + 1u]);
+                }
+                out << string_view_t{"}"};
+                break;
+            }
+            case value_enum::array: {
+                out << string_view_t{"["};
+                auto children = _children(node);
+                for (size_type i = 0u; i < node->size; ++i) {
+                    if (i != 0u) {
+                        out << comma_str;
+                    }
+                    _to(out, children[i]);
+                }
+                out << string_view_t{"]"};
+                break;
+            }
+            case value_enum::string: {
+                out << quote_str << _text(node) << quote_str;
+                break;
+            }
+            case value_enum::number:
+            case value_enum::boolean: {
+                out << _text(node);
+                break;
+            }
+            default: {
+                out << string::null_str<Char>;
+            }
+        }
+    }
+
+public:
+    ALWAYS_INLINE frozen() = default;
+
+    template <memory_policy Policy, class Allocator>
+    ALWAYS_INLINE explicit frozen(value<Char, Policy, Allocator> const& json)
+            : _node(_freeze(json)) {}
+
+    ALWAYS_INLINE frozen(self const& o) noexcept : _node(_retain(o._node)) {}
+    ALWAYS_INLINE frozen(self&& o) noexcept : _node(o._node) { o._node = nullptr; }
+
+    ALWAYS_INLINE self& operator=(self const& o) noexcept {
+        auto node = _retain(o._node);
+        _release(_node);
+        _node = node;
+        return *this;
+    }
+
+    ALWAYS_INLINE self& operator=(self&& o) noexcept {
+        if (this != &o) {
+            _release(_node);
+            _node = o._node;
+            o._node = nullptr;
+        }
+        return *this;
+    }
+
+    ALWAYS_INLINE ~frozen() { _release(_node); }
+
+    NODISCARD ALWAYS_INLINE value_enum type() const noexcept {
+        return _node != nullptr ? _node->type : value_enum::null;
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return _node == nullptr; }
+    NODISCARD ALWAYS_INLINE explicit operator bool_t() const noexcept { return !empty(); }
+
+    /* 容器的子结点数, 对象为成员数 */
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept {
+        return _node != nullptr && _is_container(_node->type) ? _node->size : 0u;
+    }
+
+    /* 共享同一个结点的句柄数, null 为 0 */
+    NODISCARD ALWAYS_INLINE size_t use_count() const noexcept {
+        return _node != nullptr ? __atomic_load_n(&_node->refs, __ATOMIC_RELAXED) : 0u;
+    }
+
+    /* 是否为同一个结点, 用于判断子树是否被共享 */
+    NODISCARD ALWAYS_INLINE bool_t same(self const& o) const noexcept { return _node == o._node; }
+
+    /* 键按转义后的原文比较, 找不到返回 null */
+    NODISCARD self operator[](string_view_t key) const {
+        throw_if(type() != value_enum::object, "not object");
+        auto pos = _find(_node, key);
+        return self(pos < _node->size ? _retain(_children(_node)[2u * pos + 1u]) : nullptr);
+    }
+
+    /* 数组的元素或对象的第 index 个成员的值, 越界返回 null */
+    NODISCARD self at(size_type index) const {
+        throw_if(!_is_container(type()), "not container");
+        if (index >= _node->size) {
+            return self();
+        }
+        auto width = _node->type == value_enum::object ? 2u : 1u;
+        return self(_retain(_children(_node)[index * width + width - 1u]));
+    }
+
+    NODISCARD string_view_t key(size_type index) const {
+        throw_if(type() != value_enum::object || index >= _node->size, "not object");
+        return _text(_children(_node)[2u * index]);
+    }
+
+    /* 找不到返回 null */
+    NODISCARD self resolve(pointer_type const& path) const {
+        auto node = _node;
+        for (size_type i = 0u; i < path.size() && node != nullptr; ++i) {
+            auto key = path[i];
+            if (node->type == value_enum::object) {
+                auto pos = _find(node, key);
+                node = pos < node->size ? _children(node)[2u * pos + 1u] : nullptr;
+            } else if (node->type == value_enum::array) {
+                auto pos = pointer_type::_index(key);
+                node = pos < node->size ? _children(node)[pos] : nullptr;
+            } else {
+                node = nullptr;
+            }
+        }
+        return self(_retain(node));
+    }
+
+    /* 按 RFC 6902 add 的语义: 对象中不存在的键追加在末尾, 数组下标等于长度或 "-" 时追加;
+     * 中间路径不存在时抛出异常. 原文档不变 */
+    NODISCARD self set(pointer_type const& path, self value) const {
+        if (path.empty()) {
+            return value;
+        }
+        auto child = value._node;
+        value._node = nullptr;
+        try {
+            return self(_update(_node, path, 0u, child, False));
+        } catch (...) {
+            _release(child);
+            throw;
+        }
+    }
+
+    NODISCARD self erase(pointer_type const& path) const {
+        throw_if(path.empty(), "path not found");
+        return self(_update(_node, path, 0u, nullptr, True));
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_number_v<T>, T> get() const {
+        throw_if(type() != value_enum::number, "not number");
+        using number_type = value<Char, view>;
+        typename number_type::number_cache cache;
+        switch (number_type::_decode_number(_text(_node), cache)) {
+            case number_enum::int64:
+                return T(cache.i);
+            case number_enum::uint64:
+                return T(cache.u);
+            case number_enum::float64:
+                return T(cache.f);
+            default:
+                __throw("not number");
+        }
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, bool_t>, T> get() const {
+        throw_if(type() != value_enum::boolean, "not boolean");
+        return _text(_node) == string::true_str<Char>;
+    }
+
+    /* 返回转义后的原文 */
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_view_t>, T> get() const {
+        throw_if(type() != value_enum::string, "not str");
+        return _text(_node);
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_t>, T> get() const {
+        return value<Char, view>(get<string_view_t>()).template get<string_t>();
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE T get(T&& default_value) const {
+        if (empty()) {
+            return qlib::forward<T>(default_value);
+        }
+        return get<T>();
+    }
+
+    template <class OutStream>
+    ALWAYS_INLINE OutStream& to(OutStream& out) const {
+        _to(out, _node);
+        return out;
+    }
+
+    NODISCARD ALWAYS_INLINE auto to() const {
+        string_t out(1024u);
+        to(out);
+        return out;
+    }
+};
+
+/* RFC 6902 JSON Patch 与 RFC 7386 Merge Patch, 直接修改 json::value, 不经过序列化.
+ * 新结点从目标文档的分配器分配; 目标为 view 策略时, 新的值与合并的键引用补丁的文本,
+ * 路径中新增的键复制到目标文档的分配器, 因此要求 pool_allocator 之类的分配器 */
+template <class Json>
+class patcher final : public object {
+public:
+    using json_type = Json;
+    using char_type = typename json_type::char_type;
+    using string_view_t = string::view<char_type>;
+    using string_t = string::value<char_type>;
+    using pointer_type = pointer<char_type>;
+    using size_type = uint32_t;
+    using path_type = vector_t<char_type>;
+
+protected:
+    /* 数组的下标, "-" 表示末尾之后 */
+    NODISCARD ALWAYS_INLINE static size_type _index(json_type const& array, string_view_t key) {
+        return key == string_view_t("-") ? size_type(array.array().size())
+                                         : pointer_type::_index(key);
+    }
+
+    NODISCARD static json_type* _child(json_type* node, string_view_t key) {
+        if (node->type() == value_enum::object) {
+            auto it = node->find(key);
+            return it != node->_object().end() ? &it->value : nullptr;
+        }
+        if (node->type() == value_enum::array) {
+            auto index = pointer_type::_index(key);
+            return index < node->array().size() ? &node->array()[index] : nullptr;
+        }
+        return nullptr;
+    }
+
+    /* 前 depth 段路径指向的结点, 不存在返回 nullptr */
+    NODISCARD static json_type* _resolve(json_type* node, pointer_type const& path, size_type depth) {
+        for (size_type i = 0u; i < depth && node != nullptr; ++i) {
+            node = _child(node, path[i]);
+        }
+        return node;
+    }
+
+    template <class Vector, class T>
+    static void _insert(Vector& vector, size_type pos, T&& item) {
+        vector.emplace_back(qlib::forward<T>(item));
+        for (auto i = size_type(vector.size()) - 1u; i > pos; --i) {
+            auto tmp = qlib::move(vector[i]);
+            vector[i] = qlib::move(vector[i - 1u]);
+            vector[i - 1u] = qlib::move(tmp);
+        }
+    }
+
+    template <class Vector>
+    static void _erase(Vector& vector, size_type pos) {
+        for (auto i = pos; i + 1u < vector.size(); ++i) {
+            vector[i] = qlib::move(vector[i + 1u]);
+        }
+        vector.pop_back();
+    }
+
+    /* 删除成员后哈希索引失效, 下次查找时重建 */
+    static void _erase_member(json_type* object, size_type pos) {
+        _erase(object->object(), pos);
+    }
+
+    /* pointer 中的键与文档中的键一样是转义后的原文, 但随 pointer 一起释放;
+     * view 策略下复制到目标文档的分配器, copy 策略由 _object_emplace 复制 */
+    template <class T = json_type>
+    NODISCARD static enable_if_t<is_same_v<typename T::key_type, string_view_t>, string_view_t>
+    _own_key(json_type* json, string_view_t key) {
+        static_assert(!is_same_v<typename T::allocator_type, new_allocator_t>,
+                      "patching a json::view document needs an arena allocator (pool_allocator_t)");
+        if (key.empty()) {
+            return key;
+        }
+        auto impl = json->allocator().template allocate<char_type>(key.size());
+        _memcpy_(impl, key.data(), key.size() * sizeof(char_type));
+        return string_view_t(impl, impl + key.size());
+    }
+
+    template <class T = json_type>
+    NODISCARD static enable_if_t<!is_same_v<typename T::key_type, string_view_t>, string_view_t>
+    _own_key(json_type* json ATTR_UNUSED, string_view_t key) {
+        return key;
+    }
+
+    NODISCARD static int32_t _add(json_type* json, pointer_type const& path, json_type&& value) {
+        if (path.empty()) {
+            *json = qlib::move(value);
+            return 0;
+        }
+        auto parent = _resolve(json, path, path.size() - 1u);
+        auto key = path[path.size() - 1u];
+        if (parent != nullptr && parent->type() == value_enum::object) {
+            auto it = parent->find(key);
+            if (it == parent->_object().end()) {
+                parent->_object_emplace(parent->_object(), _own_key(json, key));
+                it = parent->_object().end() - 1;
+            }
+            it->value = qlib::move(value);
+            return 0;
+        }
+        if (parent != nullptr && parent->type() == value_enum::array) {
+            auto pos = _index(*parent, key);
+            if (pos <= parent->array().size()) {
+                _insert(parent->array(), pos, qlib::move(value));
+                return 0;
+            }
+        }
+        return int32_t(error::path_not_found);
+    }
+
+    NODISCARD static int32_t _remove(json_type* json, pointer_type const& path) {
+        auto parent = path.empty() ? nullptr : _resolve(json, path, path.size() - 1u);
+        auto key = path.empty() ? string_view_t() : path[path.size() - 1u];
+        if (parent != nullptr && parent->type() == value_enum::object) {
+            auto it = parent->find(key);
+            if (it != parent->_object().end()) {
+                _erase_member(parent, size_type(it - parent->_object().begin()));
+                return 0;
+            }
+        } else if (parent != nullptr && parent->type() == value_enum::array) {
+            auto pos = pointer_type::_index(key);
+            if (pos < parent->array().size()) {
+                _erase(parent->array(), pos);
+                return 0;
+            }
+        }
+        return int32_t(error::path_not_found);
+    }
+
+    template <class Patch>
+    NODISCARD static Patch const* _member(Patch const& op, string_view_t key) {
+        auto it = op.find(key);
+        return it != op.object().end() ? &it->value : nullptr;
+    }
+
+    /* 路径是 JSON 字符串, 先去掉转义再切分; 只读取原文, 与补丁的策略和分配器无关 */
+    template <class Patch>
+    NODISCARD static bool_t _path(Patch const& op, string_view_t key, pointer_type& path) {
+        auto text = _member(op, key);
+        if (text == nullptr || text->type() != value_enum::string) {
+            return False;
+        }
+        auto raw = text->template get<typename Patch::string_view_t>();
+        auto result = True;
+        unescape(string_view_t(raw.begin(), raw.end()), [&](string_view_t unescaped) {
+            if (!unescaped.empty() && unescaped[0u] != '/') {
+                result = False;
+                return;
+            }
+            try {
+                path = pointer_type(unescaped);
+            } catch (exception const& _) {
+                result = False;
+            }
+        });
+        return result;
+    }
+
+    template <class Patch>
+    NODISCARD static int32_t _apply(json_type* json, Patch const& op) {
+        pointer_type path, from;
+        auto name = _member(op, "op");
+        if (name == nullptr || name->type() != value_enum::string || !_path(op, "path", path)) {
+            return int32_t(error::invalid_patch);
+        }
+        auto type = name->template get<string_view_t>();
+        auto value = _member(op, "value");
+        if (type == string_view_t("add") || type == string_view_t("replace") ||
+            type == string_view_t("test")) {
+            if (value == nullptr) {
+                return int32_t(error::invalid_patch);
+            }
+            if (type == string_view_t("add")) {
+                return _add(json, path, json_type(*value, json->allocator()));
+            }
+            auto node = _resolve(json, path, path.size());
+            if (node == nullptr) {
+                return int32_t(error::path_not_found);
+            }
+            if (type == string_view_t("test")) {
+                return *node == *value ? 0 : int32_t(error::test_failed);
+            }
+            *node = json_type(*value, json->allocator());
+            return 0;
+        }
+        if (type == string_view_t("remove")) {
+            return _remove(json, path);
+        }
+        if (type != string_view_t("move") && type != string_view_t("copy")) {
+            return int32_t(error::invalid_patch);
+        }
+        if (!_path(op, "from", from)) {
+            return int32_t(error::invalid_patch);
+        }
+        auto node = _resolve(json, from, from.size());
+        if (node == nullptr) {
+            return int32_t(error::path_not_found);
+        }
+        if (type == string_view_t("copy")) {
+            return _add(json, path, json_type(*node, json->allocator()));
+        }
+        /* 不能移动到自己的子结点中 */
+        size_type i = 0u;
+        while (i < from.size() && i < path.size() && from[i] == path[i]) {
+            ++i;
+        }
+        if (i == from.size()) {
+            return i == path.size() ? 0 : int32_t(error::invalid_patch);
+        }
+        json_type moved(qlib::move(*node));
+        auto result = _remove(json, from);
+        return result != 0 ? result : _add(json, path, qlib::move(moved));
+    }
+
+    template <class Patch>
+    static void _merge(json_type* json, Patch const& patch) {
+        if (patch.type() != value_enum::object) {
+            *json = json_type(patch, json->allocator());
+            return;
+        }
+        if (json->type() != value_enum::object) {
+            *json = json_type(typename json_type::object_type(json->allocator()), json->allocator());
+        }
+        for (auto& item : patch.object()) {
+            string_view_t key(item.key.begin(), item.key.end());
+            auto it = json->find(key);
+            if (item.value.type() == value_enum::null) {
+                if (it != json->_object().end()) {
+                    _erase_member(json, size_type(it - json->_object().begin()));
+                }
+                continue;
+            }
+            if (it == json->_object().end()) {
+                json->_object_emplace(json->_object(), key);
+                it = json->_object().end() - 1;
+            }
+            _merge(&it->value, item.value);
+        }
+    }
+
+    /* 键转成 pointer 的一段: 先去掉 JSON 转义, 再把 '~' 与 '/' 写成 "~0" 与 "~1" */
+    static void _push(path_type& path, string_view_t key) {
+        path.emplace_back(char_type('/'));
+        auto plain = True;
+        for (auto c : key) {
+            plain = plain && c != '\\' && c != '~' && c != '/';
+        }
+        if (plain) {
+            for (auto c : key) {
+                path.emplace_back(c);
+            }
+            return;
+        }
+        auto text = value<char_type, view>(key).template get<string_t>();
+        for (auto c : text) {
+            if (c == '~' || c == '/') {
+                path.emplace_back(char_type('~'));
+                c = c == '~' ? char_type('0') : char_type('1');
+            }
+            path.emplace_back(c);
+        }
+    }
+
+    static void _push(path_type& path, size_type index) {
+        char_type s[16];
+        auto last = string::to_chars(s, s + 16, index);
+        path.emplace_back(char_type('/'));
+        for (auto p = s; p < last; ++p) {
+            path.emplace_back(*p);
+        }
+    }
+
+    template <class Value>
+    static void _op(json_type* patch, string_view_t type, path_type const& path, Value const* value) {
+        auto& allocator = patch->allocator();
+        string_t escaped;
+        escape(escaped, string_view_t(path.data(), path.data() + path.size()));
+        json_type op(typename json_type::object_type(3u, allocator), allocator);
+        op._object_emplace(op.object(), "op");
+        op.object().back().value = json_type(type, allocator);
+        op._object_emplace(op.object(), "path");
+        op.object().back().value = json_type(string_view_t(escaped.begin(), escaped.end()), allocator);
+        if (value != nullptr) {
+            op._object_emplace(op.object(), "value");
+            op.object().back().value = json_type(*value, allocator);
+        }
+        patch->array().emplace_back(qlib::move(op));
+    }
+
+    template <class From, class To>
+    static void _diff(json_type* patch, path_type& path, From const& from, To const& to) {
+        auto size = path.size();
+        if (from.type() == value_enum::object && to.type() == value_enum::object) {
+            for (auto& item : from.object()) {
+                string_view_t key(item.key.begin(), item.key.end());
+                if (to.find(key) == to.object().end()) {
+                    _push(path, key);
+                    _op(patch, "remove", path, (To const*)(nullptr));
+                    path.resize(size);
+                }
+            }
+            for (auto& item : to.object()) {
+                string_view_t key(item.key.begin(), item.key.end());
+                auto it = from.find(key);
+                _push(path, key);
+                if (it == from.object().end()) {
+                    _op(patch, "add", path, &item.value);
+                } else {
+                    _diff(patch, path, it->value, item.value);
+                }
+                path.resize(size);
+            }
+            return;
+        }
+        if (from.type() == value_enum::array && to.type() == value_enum::array) {
+            auto& a = from.array();
+            auto& b = to.array();
+            auto common = a.size() < b.size() ? a.size() : b.size();
+            for (size_type i = 0u; i < common; ++i) {
+                _push(path, i);
+                _diff(patch, path, a[i], b[i]);
+                path.resize(size);
+            }
+            /* 多余的元素从后往前删除, 下标保持有效 */
+            for (auto i = size_type(a.size()); i > common; --i) {
+                _push(path, i - 1u);
+                _op(patch, "remove", path, (To const*)(nullptr));
+                path.resize(size);
+            }
+            for (auto i = size_type(common); i < b.size(); ++i) {
+                _push(path, i);
+                _op(patch, "add", path, &b[i]);
+                path.resize(size);
+            }
+            return;
+        }
+        if (!(from == to)) {
+            _op(patch, "replace", path, &to);
+        }
+    }
+
+public:
+    /* 执行一个操作 */
+    template <class Patch>
+    NODISCARD static int32_t apply(json_type* json, Patch const& op) {
+        return op.type() == value_enum::object ? _apply(json, op) : int32_t(error::invalid_patch);
+    }
+
+    template <class Patch>
+    static void merge(json_type* json, Patch const& patch) {
+        _merge(json, patch);
+    }
+
+    template <class From, class To>
+    static void diff(json_type* patch, From const& from, To const& to) {
+        path_type path;
+        _diff(patch, path, from, to);
+    }
+};
+
+/* 按顺序执行补丁中的操作, 出错时停止并返回错误码, failed 为出错的操作下标;
+ * 出错之前的操作已经生效, 需要全部或全不生效时对副本执行 */
+template <class Json, class Patch>
+int32_t apply_patch(Json* json, Patch const& patch, size_t* failed = nullptr) {
+    if (patch.type() != value_enum::array) {
+        return int32_t(error::invalid_patch);
+    }
+    auto& ops = patch.array();
+    for (size_t i = 0u; i < ops.size(); ++i) {
+        auto result = patcher<Json>::apply(json, ops[i]);
+        if (result != 0) {
+            if (failed != nullptr) {
+                *failed = i;
+            }
+            return result;
+        }
+    }
+    return 0;
+}
+
+/* RFC 7386: 对象逐个成员合并, null 表示删除, 其余类型整体替换 */
+template <class Json, class Patch>
+void merge_patch(Json* json, Patch const& patch) {
+    patcher<Json>::merge(json, patch);
+}
+
+/* 生成把 from 变为 to 的 JSON Patch, 写入 patch (数组); 补丁的大小与差异成正比.
+ * 数组按下标逐个比较, 不检测元素的插入与移动 */
+template <class Json, class From, class To>
+void diff(Json* patch, From const& from, To const& to) {
+    static_assert(!is_same_v<typename Json::string_type, typename Json::string_view_t>,
+                  "diff writes new strings and requires json::copy");
+    *patch = Json(typename Json::array_type(patch->allocator()), patch->allocator());
+    patcher<Json>::diff(patch, from, to);
+}
+
+/* 扁平文档: 整棵树是一段连续的 64 位字(高 8 位为标记)加一个字符串缓冲区, 只读.
+ * 容器起始字记录子结点数与兄弟结点的下标, 跳过子树为 O(1); 字符串与数值占两个字(偏移, 长度) */
+template <class Char = char, class Allocator = new_allocator_t>
+class tape final : public object {
+public:
+    using self = tape;
+    using char_type = Char;
+    using allocator_type = Allocator;
+    using word_type = uint64_t;
+    using size_type = uint32_t;
+    using string_view_t = string::view<Char>;
+    using string_t = string::value<Char>;
+
+    enum : uint8_t {
+        object_begin = '{',
+        object_end = '}',
+        array_begin = '[',
+        array_end = ']',
+        string_tag = '"',
+        number_tag = 'd',
+        true_tag = 't',
+        false_tag = 'f',
+        null_tag = 'n',
+    };
+
+protected:
+    template <class, class>
+    friend class compact;
+
+    struct frame final {
+        size_type begin;
+        size_type count;
+        bool_t is_object;
+    };
+
+    vector_t<word_type, Allocator> _tape;
+    vector_t<Char, Allocator> _strings;
+    vector_t<frame, Allocator> _frames;
+    structural_index<Allocator> _index;
+
+    NODISCARD ALWAYS_INLINE static constexpr word_type _word(uint8_t tag, uint64_t payload) noexcept {
+        return (word_type(tag) << 56) | payload;
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_number(Char c) noexcept {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' ||
+               c == 'E';
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_delimiter(Char c) noexcept {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == ':' ||
+               c == '}' || c == ']';
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_literal(Char const* p,
+                                                      Char const* end,
+                                                      string_view_t literal) noexcept {
+        auto stop = p + literal.size();
+        if (unlikely(stop > end || !equal(literal.begin(), literal.end(), p))) {
+            return False;
+        }
+        return stop == end || _is_delimiter(*stop);
+    }
+
+public:
+    /* 只读结点句柄, 接口与 json_view_t/document_view 的访问器一致 */
+    class node final : public object {
+    protected:
+        tape const* _tape{nullptr};
+        size_type _index{0u};
+
+        NODISCARD ALWAYS_INLINE word_type _at(size_type index) const noexcept {
+            return _tape->_tape[index];
+        }
+
+        NODISCARD ALWAYS_INLINE uint8_t _tag() const noexcept {
+            return _tape == nullptr ? uint8_t(null_tag) : uint8_t(_at(_index) >> 56);
+        }
+
+        NODISCARD ALWAYS_INLINE string_view_t _text() const noexcept {
+            auto offset = size_type(_at(_index));
+            auto first = _tape->_strings.data() + offset;
+            return string_view_t(first, first + _at(_index + 1u));
+        }
+
+        friend class tape;
+
+    public:
+        struct member final {
+            string_view_t key;
+            node value;
+        };
+
+        ALWAYS_INLINE node() = default;
+        ALWAYS_INLINE node(tape const* tape, size_type index) noexcept
+                : _tape(tape), _index(index) {}
+
+        /* 兄弟结点在 tape 中的下标 */
+        NODISCARD ALWAYS_INLINE size_type next() const noexcept {
+            switch (_tag()) {
+                case object_begin:
+                case array_begin:
+                    return size_type(_at(_index));
+                case string_tag:
+                case number_tag:
+                    return _index + 2u;
+                default:
+                    return _index + 1u;
+            }
+        }
+
+        NODISCARD ALWAYS_INLINE value_enum type() const noexcept {
+            switch (_tag()) {
+                case object_begin:
+                    return value_enum::object;
+                case array_begin:
+                    return value_enum::array;
+                case string_tag:
+                    return value_enum::string;
+                case number_tag:
+                    return value_enum::number_ref;
+                case true_tag:
+                case false_tag:
+                    return value_enum::boolean;
+                default:
+                    return value_enum::null;
+            }
+        }
+
+        NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return type() == value_enum::null; }
+        NODISCARD ALWAYS_INLINE explicit operator bool_t() const noexcept { return !empty(); }
+
+        /* 容器的子结点数, O(1) */
+        NODISCARD ALWAYS_INLINE size_type size() const noexcept {
+            auto tag = _tag();
+            if (tag != object_begin && tag != array_begin) {
+                return 0u;
+            }
+            return size_type((_at(_index) >> 32) & 0xFFFFFFu);
+        }
+
+        class iterator final : public object {
+        protected:
+            tape const* _tape{nullptr};
+            size_type _cur{0u};
+            bool_t _is_object{False};
+            member _member{};
+
+            ALWAYS_INLINE void _load() noexcept {
+                auto tag = uint8_t(_tape->_tape[_cur] >> 56);
+                if (tag == object_end || tag == array_end) {
+                    return;
+                }
+                auto cur = _cur;
+                if (_is_object) {
+                    _member.key = node(_tape, cur)._text();
+                    cur += 2u;
+                }
+                _member.value = node(_tape, cur);
+            }
+
+        public:
+            ALWAYS_INLINE iterator() = default;
+            ALWAYS_INLINE iterator(tape const* tape, size_type cur, bool_t is_object) noexcept
+                    : _tape(tape), _cur(cur), _is_object(is_object) {
+                if (_tape != nullptr) {
+                    _load();
+                }
+            }
+
+            NODISCARD ALWAYS_INLINE member const& operator*() const noexcept { return _member; }
+            NODISCARD ALWAYS_INLINE member const* operator->() const noexcept { return &_member; }
+
+            ALWAYS_INLINE iterator& operator++() noexcept {
+                _cur = _member.value.next();
+                _load();
+                return *this;
+            }
+
+            NODISCARD ALWAYS_INLINE bool_t operator==(iterator const& o) const noexcept {
+                return _cur == o._cur;
+            }
+            NODISCARD ALWAYS_INLINE bool_t operator!=(iterator const& o) const noexcept {
+                return _cur != o._cur;
+            }
+        };
+
+        /* 数组按值遍历, 与 json::value::array() 一致 */
+        class array_iterator final : public object {
+        protected:
+            node _node{};
+
+        public:
+            ALWAYS_INLINE array_iterator() = default;
+            ALWAYS_INLINE explicit array_iterator(node node) noexcept : _node(node) {}
+
+            NODISCARD ALWAYS_INLINE node const& operator*() const noexcept { return _node; }
+            NODISCARD ALWAYS_INLINE node const* operator->() const noexcept { return &_node; }
+
+            ALWAYS_INLINE array_iterator& operator++() noexcept {
+                _node._index = _node.next();
+                return *this;
+            }
+
+            NODISCARD ALWAYS_INLINE bool_t operator==(array_iterator const& o) const noexcept {
+                return _node._index == o._node._index;
+            }
+            NODISCARD ALWAYS_INLINE bool_t operator!=(array_iterator const& o) const noexcept {
+                return _node._index != o._node._index;
+            }
+        };
+
+        template <class Iter>
+        struct range final {
+            Iter first;
+            Iter last;
+
+            NODISCARD ALWAYS_INLINE Iter begin() const noexcept { return first; }
+            NODISCARD ALWAYS_INLINE Iter end() const noexcept { return last; }
+        };
+
+        NODISCARD ALWAYS_INLINE iterator begin() const noexcept {
+            auto tag = _tag();
+            if (tag != object_begin && tag != array_begin) {
+                return end();
+            }
+            return iterator(_tape, _index + 1u, tag == object_begin);
+        }
+
+        NODISCARD ALWAYS_INLINE iterator end() const noexcept {
+            auto tag = _tag();
+            if (tag != object_begin && tag != array_begin) {
+                return iterator(nullptr, 0u, False);
+            }
+            return iterator(nullptr, size_type(_at(_index)) - 1u, False);
+        }
+
+        NODISCARD ALWAYS_INLINE range<iterator> object() const {
+            throw_if(_tag() != object_begin, "not object");
+            return range<iterator>{begin(), end()};
+        }
+
+        NODISCARD ALWAYS_INLINE range<array_iterator> array() const {
+            throw_if(_tag() != array_begin, "not array");
+            auto last = size_type(_at(_index)) - 1u;
+            return range<array_iterator>{array_iterator(node(_tape, _index + 1u)),
+                                         array_iterator(node(_tape, last))};
+        }
+
+        NODISCARD ALWAYS_INLINE node operator[](string_view_t key) const {
+            throw_if(_tag() != object_begin, "not object");
+            for (auto it = begin(); it != end(); ++it) {
+                if (it->key == key) {
+                    return it->value;
+                }
+            }
+            return node{};
+        }
+
+        NODISCARD ALWAYS_INLINE node at(size_type index) const {
+            throw_if(_tag() != array_begin, "not array");
+            if (index >= size()) {
+                return node{};
+            }
+            auto cur = node(_tape, _index + 1u);
+            for (; index > 0u; --index) {
+                cur._index = cur.next();
+            }
+            return cur;
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_number_v<T>, T> get() const {
+            throw_if(_tag() != number_tag, "not number");
+            auto text = _text();
+            T value{};
+            converter<T>::decode(value, text.begin(), text.end());
+            return value;
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, bool_t>, T> get() const {
+            auto tag = _tag();
+            throw_if(tag != true_tag && tag != false_tag, "not boolean");
+            return tag == true_tag;
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_view_t>, T> get() const {
+            throw_if(_tag() != string_tag, "not str");
+            return _text();
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_t>, T> get() const {
+            return value<Char, view>(get<string_view_t>()).template get<string_t>();
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE T get(T&& default_value) const {
+            if (empty()) {
+                return qlib::forward<T>(default_value);
+            }
+            return get<T>();
+        }
+
+        template <class OutStream>
+        OutStream& to(OutStream& out) const {
+            constexpr string_view_t quote_str{"\""};
+            constexpr string_view_t comma_str{","};
+            constexpr string_view_t colon_str{":"};
+
+            switch (_tag()) {
+                case object_begin: {
+                    out << string_view_t{"{"};
+                    for (auto it = begin(); it != end();) {
+                        out << quote_str << it->key << quote_str << colon_str;
+                        it->value.to(out);
+                        ++it;
+                        if (likely(it != end())) {
+                            out << comma_str;
+                        }
+                    }
+                    out << string_view_t{"}"};
+                    break;
+                }
+                case array_begin: {
+                    out << string_view_t{"["};
+                    for (auto it = begin(); it != end();) {
+                        it->value.to(out);
+                        ++it;
+                        if (likely(it != end())) {
+                            out << comma_str;
+                        }
+                    }
+                    out << string_view_t{"]"};
+                    break;
+                }
+                case string_tag: {
+                    out << quote_str << _text() << quote_str;
+                    break;
+                }
+                case number_tag: {
+                    out << _text();
+                    break;
+                }
+                case true_tag: {
+                    out << string::true_str<Char>;
+                    break;
+                }
+                case false_tag: {
+                    out << string::false_str<Char>;
+                    break;
+                }
+                default: {
+                    out << string::null_str<Char>;
+                }
+            }
+            return out;
+        }
+
+        NODISCARD ALWAYS_INLINE auto to() const {
+            string_t out(1024u);
+            to(out);
+            return out;
+        }
+    };
+
+    ALWAYS_INLINE tape() = default;
+    ALWAYS_INLINE explicit tape(allocator_type& allocator)
+            : _tape(allocator), _strings(allocator), _frames(allocator), _index(allocator) {}
+
+    /* 复用已有的缓冲区, 重复解析时不再分配 */
+    int32_t parse(Char const* begin, Char const* end) {
+        _tape.resize(0u);
+        _strings.resize(0u);
+        _frames.resize(0u);
+        int32_t result = _index.build(begin, end);
+        if (unlikely(result != 0)) {
+            return result;
+        }
+
+        /* 每个结构位置最多产生两个字, 字符串与数值的原文不超过输入长度 */
+        _tape.reserve(_index.size() * 2u + 2u);
+        _strings.reserve(size_type(end - begin) + 1u);
+        auto out = _tape.data();
+        auto text = _strings.data();
+        size_type size{0u};
+        size_type text_size{0u};
+
+        auto pos = _index.begin();
+        auto last = _index.end();
+        auto push_text = [&](uint8_t tag, Char const* first, Char const* stop) {
+            auto length = size_type(stop - first);
+            _memcpy_(text + text_size, first, length * sizeof(Char));
+            out[size++] = _word(tag, text_size);
+            out[size++] = length;
+            text_size += length;
+        };
+
+        do {
+            if (unlikely(pos == last || (begin[*pos] != '{' && begin[*pos] != '['))) {
+                result = int32_t(error::missing_left_brace);
+                break;
+            }
+            _frames.emplace_back(frame{size, 0u, begin[*pos] == '{'});
+            out[size++] = 0u;
+            ++pos;
+
+            bool_t first{True};
+            while (!result) {
+                if (unlikely(pos == last)) {
+                    result = int32_t(error::missing_right_brace);
+                    break;
+                }
+
+                auto& top = _frames.back();
+                auto c = begin[*pos];
+                if (c == (top.is_object ? '}' : ']')) {
+                    auto count = top.count < 0xFFFFFFu ? top.count : 0xFFFFFFu;
+                    out[top.begin] = _word(top.is_object ? object_begin : array_begin,
+                                           (uint64_t(count) << 32) | (size + 1u));
+                    out[size++] = _word(uint8_t(c), top.begin);
+                    _frames.pop_back();
+                    ++pos;
+                    first = False;
+                    if (_frames.empty()) {
+                        break;
+                    }
+                    continue;
+                }
+
+                if (!first) {
+                    if (unlikely(c != ',')) {
+                        result = int32_t(error::missing_comma);
+                        break;
+                    }
+                    if (unlikely(++pos == last)) {
+                        result = int32_t(error::missing_right_brace);
+                        break;
+                    }
+                    c = begin[*pos];
+                }
+
+                if (top.is_object) {
+                    if (unlikely(c != '"')) {
+                        result = int32_t(error::missing_left_quote);
+                        break;
+                    }
+                    if (unlikely(pos + 1 == last)) {
+                        result = int32_t(error::missing_right_quote);
+                        break;
+                    }
+                    push_text(string_tag, begin + pos[0] + 1, begin + pos[1]);
+                    pos += 2;
+                    if (unlikely(pos == last || begin[*pos] != ':')) {
+                        result = int32_t(error::missing_colon);
+                        break;
+                    }
+                    if (unlikely(++pos == last)) {
+                        result = int32_t(error::missing_right_brace);
+                        break;
+                    }
+                    c = begin[*pos];
+                }
+                ++top.count;
+
+                auto p = begin + *pos;
+                switch (c) {
+                    case '"': {
+                        if (unlikely(pos + 1 == last)) {
+                            result = int32_t(error::missing_right_quote);
+                            break;
+                        }
+                        push_text(string_tag, p + 1, begin + pos[1]);
+                        pos += 2;
+                        break;
+                    }
+                    case '{':
+                    case '[': {
+                        _frames.emplace_back(frame{size, 0u, c == '{'});
+                        out[size++] = 0u;
+                        ++pos;
+                        first = True;
+                        continue;
+                    }
+                    case 'n': {
+                        if (likely(_is_literal(p, end, string::null_str<Char>))) {
+                            out[size++] = _word(null_tag, 0u);
+                        } else {
+                            result = int32_t(error::invalid_null);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    case 't': {
+                        if (likely(_is_literal(p, end, string::true_str<Char>))) {
+                            out[size++] = _word(true_tag, 0u);
+                        } else {
+                            result = int32_t(error::invalid_boolean);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    case 'f': {
+                        if (likely(_is_literal(p, end, string::false_str<Char>))) {
+                            out[size++] = _word(false_tag, 0u);
+                        } else {
+                            result = int32_t(error::invalid_boolean);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    default: {
+                        auto stop = p;
+                        while (stop < end && _is_number(*stop)) {
+                            ++stop;
+                        }
+                        if (unlikely(stop == p || (stop < end && !_is_delimiter(*stop)))) {
+                            result = int32_t(error::unknown);
+                            break;
+                        }
+                        push_text(number_tag, p, stop);
+                        ++pos;
+                    }
+                }
+                first = False;
+            }
+        } while (false);
+
+        if (unlikely(result != 0)) {
+            size = 0u;
+            text_size = 0u;
+        }
+        _tape.resize(size);
+        _strings.resize(text_size);
+        return result;
+    }
+
+    using member = typename node::member;
+
+    NODISCARD ALWAYS_INLINE node root() const noexcept {
+        return _tape.empty() ? node{} : node(this, 0u);
+    }
+
+    NODISCARD ALWAYS_INLINE size_type words() const noexcept { return _tape.size(); }
+
+    NODISCARD ALWAYS_INLINE value_enum type() const noexcept { return root().type(); }
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return root().empty(); }
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept { return root().size(); }
+    NODISCARD ALWAYS_INLINE typename node::iterator begin() const noexcept { return root().begin(); }
+    NODISCARD ALWAYS_INLINE typename node::iterator end() const noexcept { return root().end(); }
+    NODISCARD ALWAYS_INLINE node operator[](string_view_t key) const { return root()[key]; }
+    NODISCARD ALWAYS_INLINE node at(size_type index) const { return root().at(index); }
+
+    NODISCARD ALWAYS_INLINE auto object() const { return root().object(); }
+    NODISCARD ALWAYS_INLINE auto array() const { return root().array(); }
+
+    template <class OutStream>
+    ALWAYS_INLINE OutStream& to(OutStream& out) const {
+        return root().to(out);
+    }
+
+    NODISCARD ALWAYS_INLINE auto to() const { return root().to(); }
+};
+
+template <class Iter1, class Iter2, class Char, class Allocator>
+ALWAYS_INLINE int32_t parse(tape<Char, Allocator>* tape, Iter1 begin, Iter2 end) {
+    auto first = &*begin;
+    return tape->parse(first, first + (end - begin));
+}
+
+template <class Iter1, class Iter2, class Char, class Allocator>
+ALWAYS_INLINE int32_t parse(tape<Char, Allocator>* tape,
+                            Iter1 begin,
+                            Iter2 end,
+                            parse_option options ATTR_UNUSED) {
+    return parse(tape, begin, end);
+}
+
+/* 紧凑文档: 每个结点固定 16 字节, 分配器只在文档中保存一份, 只读.
+ * 首字节低 4 位为类型; 不超过 15 字节的字符串原文内联在其后, 长度在首字节高 4 位;
+ * 其余结点 [4, 8) 字节为长度或子结点数, [8, 16) 字节为数值, 字符串地址或子结点数组.
+ * 数值在解析时解码, 序列化按最短往返格式输出; 长字符串引用输入, 输入须比文档存活更久.
+ * 子结点数组从 allocator 分配且不单独释放, 因此要求 pool_allocator 之类的整体释放的分配器 */
+template <class Char, class Allocator>
+class compact final : public traits<Allocator>::reference {
+public:
+    using base = typename traits<Allocator>::reference;
+    using self = compact;
+    using char_type = Char;
+    using allocator_type = Allocator;
+    using size_type = uint32_t;
+    using string_view_t = string::view<Char>;
+    using string_t = string::value<Char>;
+
+    static_assert(!is_same_v<Allocator, new_allocator_t>,
+                  "compact needs an arena allocator (pool_allocator_t) to hold its nodes");
+
+    enum : uint8_t {
+        null_kind = 0,
+        false_kind,
+        true_kind,
+        int64_kind,
+        uint64_kind,
+        float64_kind,
+        string_kind,
+        short_string_kind,
+        array_kind,
+        object_kind,
+    };
+
+    template <class Iter>
+    struct range final {
+        Iter first;
+        Iter last;
+
+        NODISCARD ALWAYS_INLINE Iter begin() const noexcept { return first; }
+        NODISCARD ALWAYS_INLINE Iter end() const noexcept { return last; }
+    };
+
+    /* 对象的子结点按 键, 值 交替存放, 可直接按 member 数组遍历 */
+    struct member;
+
+    class alignas(8) node final : public object {
+    protected:
+        constexpr static size_type inline_capacity = sizeof(Char) == 1u ? 15u : 0u;
+
+        uint8_t _impl[16]{};
+
+        NODISCARD ALWAYS_INLINE uint8_t _kind() const noexcept { return _impl[0] & 0x0Fu; }
+
+        NODISCARD ALWAYS_INLINE size_type _size() const noexcept {
+            size_type size;
+            _memcpy_(&size, _impl + 4, sizeof(size));
+            return size;
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE T _payload() const noexcept {
+            T value;
+            _memcpy_(&value, _impl + 8, sizeof(T));
+            return value;
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE static node _make(uint8_t kind, size_type size, T payload) noexcept {
+            static_assert(sizeof(T) <= 8u, "payload too large");
+            node result;
+            result._impl[0] = kind;
+            _memcpy_(result._impl + 4, &size, sizeof(size));
+            _memcpy_(result._impl + 8, &payload, sizeof(T));
+            return result;
+        }
+
+        NODISCARD ALWAYS_INLINE static node _make_string(Char const* first, Char const* last) {
+            auto length = size_type(last - first);
+            if (length > inline_capacity) {
+                return _make(string_kind, length, first);
+            }
+            node result;
+            result._impl[0] = uint8_t(short_string_kind | (length << 4));
+            _memcpy_(result._impl + 1, first, length * sizeof(Char));
+            return result;
+        }
+
+        NODISCARD ALWAYS_INLINE string_view_t _text() const noexcept {
+            if (_kind() == short_string_kind) {
+                auto first = (Char const*)(_impl + 1);
+                return string_view_t(first, first + (_impl[0] >> 4));
+            }
+            auto first = _payload<Char const*>();
+            return string_view_t(first, first + _size());
+        }
+
+        NODISCARD ALWAYS_INLINE node const* _children() const noexcept {
+            return _payload<node const*>();
+        }
+
+        friend class compact;
+
+    public:
+        const static node default_value;
+
+        ALWAYS_INLINE node() = default;
+
+        NODISCARD ALWAYS_INLINE value_enum type() const noexcept {
+            switch (_kind()) {
+                case object_kind:
+                    return value_enum::object;
+                case array_kind:
+                    return value_enum::array;
+                case string_kind:
+                case short_string_kind:
+                    return value_enum::string;
+                case int64_kind:
+                case uint64_kind:
+                case float64_kind:
+                    return value_enum::number;
+                case true_kind:
+                case false_kind:
+                    return value_enum::boolean;
+                default:
+                    return value_enum::null;
+            }
+        }
+
+        NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return _kind() == null_kind; }
+        NODISCARD ALWAYS_INLINE explicit operator bool_t() const noexcept { return !empty(); }
+
+        /* 容器的子结点数, 对象为成员数 */
+        NODISCARD ALWAYS_INLINE size_type size() const noexcept {
+            auto kind = _kind();
+            return kind == object_kind || kind == array_kind ? _size() : 0u;
+        }
+
+        NODISCARD ALWAYS_INLINE range<member const*> object() const {
+            throw_if(_kind() != object_kind, "not object");
+            auto first = (member const*)(_children());
+            return range<member const*>{first, first + _size()};
+        }
+
+        NODISCARD ALWAYS_INLINE range<node const*> array() const {
+            throw_if(_kind() != array_kind, "not array");
+            auto first = _children();
+            return range<node const*>{first, first + _size()};
+        }
+
+        NODISCARD ALWAYS_INLINE node const& operator[](string_view_t key) const {
+            for (auto& item : object()) {
+                if (item.key._text() == key) {
+                    return item.value;
+                }
+            }
+            return default_value;
+        }
+
+        /* 数组按下标访问, O(1) */
+        NODISCARD ALWAYS_INLINE node const& at(size_type index) const {
+            throw_if(_kind() != array_kind, "not array");
+            return index < _size() ? _children()[index] : default_value;
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_number_v<T>, T> get() const {
+            switch (_kind()) {
+                case int64_kind:
+                    return T(_payload<int64_t>());
+                case uint64_kind:
+                    return T(_payload<uint64_t>());
+                case float64_kind:
+                    return T(_payload<float64_t>());
+                default:
+                    __throw("not number");
+            }
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, bool_t>, T> get() const {
+            auto kind = _kind();
+            throw_if(kind != true_kind && kind != false_kind, "not boolean");
+            return kind == true_kind;
+        }
+
+        /* 返回转义后的原文, 短字符串指向结点内部 */
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_view_t>, T> get() const {
+            auto kind = _kind();
+            throw_if(kind != string_kind && kind != short_string_kind, "not str");
+            return _text();
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<T, string_t>, T> get() const {
+            return value<Char, view>(get<string_view_t>()).template get<string_t>();
+        }
+
+        template <class T>
+        NODISCARD ALWAYS_INLINE T get(T&& default_value) const {
+            if (empty()) {
+                return qlib::forward<T>(default_value);
+            }
+            return get<T>();
+        }
+
+        template <class OutStream>
+        OutStream& to(OutStream& out) const {
+            constexpr string_view_t quote_str{"\""};
+            constexpr string_view_t comma_str{","};
+            constexpr string_view_t colon_str{":"};
+
+            switch (_kind()) {
+                case object_kind: {
+                    out << string_view_t{"{"};
+                    auto items = object();
+                    for (auto it = items.begin(); it != items.end(); ++it) {
+                        if (it != items.begin()) {
+                            out << comma_str;
+                        }
+                        out << quote_str << it->key._text() << quote_str << colon_str;
+                        it->value.to(out);
+                    }
+                    out << string_view_t{"}"};
+                    break;
+                }
+                case array_kind: {
+                    out << string_view_t{"["};
+                    auto items = array();
+                    for (auto it = items.begin(); it != items.end(); ++it) {
+                        if (it != items.begin()) {
+                            out << comma_str;
+                        }
+                        it->to(out);
+                    }
+                    out << string_view_t{"]"};
+                    break;
+                }
+                case string_kind:
+                case short_string_kind: {
+                    out << quote_str << _text() << quote_str;
+                    break;
+                }
+                case int64_kind: {
+                    _number(out, _payload<int64_t>());
+                    break;
+                }
+                case uint64_kind: {
+                    _number(out, _payload<uint64_t>());
+                    break;
+                }
+                case float64_kind: {
+                    _number(out, _payload<float64_t>());
+                    break;
+                }
+                case true_kind: {
+                    out << string::true_str<Char>;
+                    break;
+                }
+                case false_kind: {
+                    out << string::false_str<Char>;
+                    break;
+                }
+                default: {
+                    out << string::null_str<Char>;
+                }
+            }
+            return out;
+        }
+
+        NODISCARD ALWAYS_INLINE auto to() const {
+            string_t out(1024u);
+            to(out);
+            return out;
+        }
+
+    protected:
+        template <class OutStream, class T>
+        ALWAYS_INLINE static void _number(OutStream& out, T value) {
+            Char s[32]{};
+            auto last = string::to_chars(s, s + 32, value);
+            out << string_view_t(s, last);
+        }
+    };
+
+    struct member final {
+        node key;
+        node value;
+    };
+
+    static_assert(sizeof(node) == 16u, "compact node must be 16 bytes");
+    static_assert(sizeof(member) == 2u * sizeof(node), "member must be a key/value node pair");
+
+protected:
+    using scan = tape<Char, new_allocator_t>;
+    using number_type = value<Char, view>;
+
+    struct frame final {
+        size_type begin;
+        bool_t is_object;
+    };
+
+    node _root{};
+    /* 解析期间的暂存区, 在多次解析之间复用, 不计入文档 */
+    structural_index<new_allocator_t> _index;
+    vector_t<node, new_allocator_t> _stack;
+    vector_t<frame, new_allocator_t> _frames;
+
+    NODISCARD ALWAYS_INLINE allocator_type& _allocator() noexcept {
+        return static_cast<base&>(*this);
+    }
+
+    /* 容器闭合时, 暂存栈顶部的子结点整体复制到 allocator 中 */
+    NODISCARD ALWAYS_INLINE node _close(frame const& top, node const* stack, size_type& size) {
+        auto count = size - top.begin;
+        node* children{nullptr};
+        if (count > 0u) {
+            children = _allocator().template allocate<node>(count);
+            _memcpy_(children, stack + top.begin, count * sizeof(node));
+        }
+        size = top.begin;
+        return top.is_object ? node::_make(object_kind, count / 2u, (node const*)children)
+                             : node::_make(array_kind, count, (node const*)children);
+    }
+
+public:
+    ALWAYS_INLINE explicit compact(allocator_type& allocator) : base(allocator) {}
+
+    int32_t parse(Char const* begin, Char const* end) {
+        _root = node{};
+        _frames.resize(0u);
+        int32_t result = _index.build(begin, end);
+        if (unlikely(result != 0)) {
+            return result;
+        }
+
+        /* 每个值至少对应一个结构位置, 暂存栈不会超过结构位置数 */
+        _stack.reserve(_index.size() + 1u);
+        auto stack = _stack.data();
+        size_type size{0u};
+
+        auto pos = _index.begin();
+        auto last = _index.end();
+
+        do {
+            if (unlikely(pos == last || (begin[*pos] != '{' && begin[*pos] != '['))) {
+                result = int32_t(error::missing_left_brace);
+                break;
+            }
+            _frames.emplace_back(frame{size, begin[*pos] == '{'});
+            ++pos;
+
+            bool_t first{True};
+            while (!result) {
+                if (unlikely(pos == last)) {
+                    result = int32_t(error::missing_right_brace);
+                    break;
+                }
+
+                auto& top = _frames.back();
+                auto c = begin[*pos];
+                if (c == (top.is_object ? '}' : ']')) {
+                    auto value = _close(top, stack, size);
+                    _frames.pop_back();
+                    ++pos;
+                    first = False;
+                    if (_frames.empty()) {
+                        _root = value;
+                        break;
+                    }
+                    stack[size++] = value;
+                    continue;
+                }
+
+                if (!first) {
+                    if (unlikely(c != ',')) {
+                        result = int32_t(error::missing_comma);
+                        break;
+                    }
+                    if (unlikely(++pos == last)) {
+                        result = int32_t(error::missing_right_brace);
+                        break;
+                    }
+                    c = begin[*pos];
+                }
+
+                if (top.is_object) {
+                    if (unlikely(c != '"')) {
+                        result = int32_t(error::missing_left_quote);
+                        break;
+                    }
+                    if (unlikely(pos + 1 == last)) {
+                        result = int32_t(error::missing_right_quote);
+                        break;
+                    }
+                    stack[size++] = node::_make_string(begin + pos[0] + 1, begin + pos[1]);
+                    pos += 2;
+                    if (unlikely(pos == last || begin[*pos] != ':')) {
+                        result = int32_t(error::missing_colon);
+                        break;
+                    }
+                    if (unlikely(++pos == last)) {
+                        result = int32_t(error::missing_right_brace);
+                        break;
+                    }
+                    c = begin[*pos];
+                }
+
+                auto p = begin + *pos;
+                switch (c) {
+                    case '"': {
+                        if (unlikely(pos + 1 == last)) {
+                            result = int32_t(error::missing_right_quote);
+                            break;
+                        }
+                        stack[size++] = node::_make_string(p + 1, begin + pos[1]);
+                        pos += 2;
+                        break;
+                    }
+                    case '{':
+                    case '[': {
+                        _frames.emplace_back(frame{size, c == '{'});
+                        ++pos;
+                        first = True;
+                        continue;
+                    }
+                    case 'n': {
+                        if (likely(scan::_is_literal(p, end, string::null_str<Char>))) {
+                            stack[size++] = node{};
+                        } else {
+                            result = int32_t(error::invalid_null);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    case 't': {
+                        if (likely(scan::_is_literal(p, end, string::true_str<Char>))) {
+                            stack[size++] = node::_make(true_kind, 0u, uint64_t(0u));
+                        } else {
+                            result = int32_t(error::invalid_boolean);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    case 'f': {
+                        if (likely(scan::_is_literal(p, end, string::false_str<Char>))) {
+                            stack[size++] = node::_make(false_kind, 0u, uint64_t(0u));
+                        } else {
+                            result = int32_t(error::invalid_boolean);
+                        }
+                        ++pos;
+                        break;
+                    }
+                    default: {
+                        auto stop = p;
+                        while (stop < end && scan::_is_number(*stop)) {
+                            ++stop;
+                        }
+                        typename number_type::number_cache cache;
+                        auto kind = stop == p || (stop < end && !scan::_is_delimiter(*stop))
+                                        ? number_enum::none
+                                        : number_type::_decode_number(string_view_t(p, stop), cache);
+                        if (unlikely(kind == number_enum::none)) {
+                            result = int32_t(error::unknown);
+                            break;
+                        }
+                        stack[size++] = node::_make(kind == number_enum::int64    ? int64_kind
+                                                    : kind == number_enum::uint64 ? uint64_kind
+                                                                                  : float64_kind,
+                                                    0u, cache.u);
+                        ++pos;
+                    }
+                }
+                first = False;
+            }
+        } while (false);
+
+        if (unlikely(result != 0)) {
+            _root = node{};
+        }
+        return result;
+    }
+
+    NODISCARD ALWAYS_INLINE node const& root() const noexcept { return _root; }
+
+    NODISCARD ALWAYS_INLINE value_enum type() const noexcept { return _root.type(); }
+    NODISCARD ALWAYS_INLINE bool_t empty() const noexcept { return _root.empty(); }
+    NODISCARD ALWAYS_INLINE size_type size() const noexcept { return _root.size(); }
+    NODISCARD ALWAYS_INLINE node const& operator[](string_view_t key) const { return _root[key]; }
+    NODISCARD ALWAYS_INLINE node const& at(size_type index) const { return _root.at(index); }
+
+    NODISCARD ALWAYS_INLINE auto object() const { return _root.object(); }
+    NODISCARD ALWAYS_INLINE auto array() const { return _root.array(); }
+
+    template <class OutStream>
+    ALWAYS_INLINE OutStream& to(OutStream& out) const {
+        return _root.to(out);
+    }
+
+    NODISCARD ALWAYS_INLINE auto to() const { return _root.to(); }
+};
+
+template <class Char, class Allocator>
+const typename compact<Char, Allocator>::node compact<Char, Allocator>::node::default_value{};
+
+template <class Iter1, class Iter2, class Char, class Allocator>
+ALWAYS_INLINE int32_t parse(compact<Char, Allocator>* compact, Iter1 begin, Iter2 end) {
+    auto first = &*begin;
+    return compact->parse(first, first + (end - begin));
+}
+
+template <class Iter1, class Iter2, class Char, class Allocator>
+ALWAYS_INLINE int32_t parse(compact<Char, Allocator>* compact,
+                            Iter1 begin,
+                            Iter2 end,
+                            parse_option options ATTR_UNUSED) {
+    return parse(compact, begin, end);
+}
+
+/* 只校验不建树: 第一阶段每得到一块的结构位图就交给状态机, 不保存结构索引, 也不分配内存.
+ * 错误码与 parse_two_stage 的解析一致(未闭合的字符串优先报告), 嵌套深度上限为 max_depth.
+ * 比解析更严格: 按 RFC 8259 检查数字, 拒绝字符串中的控制字符与根结点之后的非空白字符 */
+template <class Char = char>
+class validator final : public object {
+public:
+    using self = validator;
+    using char_type = Char;
+
+    static_assert(sizeof(Char) == 1u, "validator only supports 8-bit characters");
+
+    enum : size_t { max_depth = 4096u };
+
+protected:
+    enum class state : uint8_t {
+        root,
+        first, /* 容器刚打开: 子结点或右括号 */
+        next,  /* 子结点之后: 逗号或右括号 */
+        key,   /* 对象中逗号之后的键 */
+        colon, /* 键之后的冒号 */
+        value, /* 冒号或数组中逗号之后的值 */
+        done,
+    };
+
+    Char const* _begin;
+    Char const* _end;
+    int32_t _error{0};
+    size_t _offset{0u};
+    size_t _depth{0u};
+    state _state{state::root};
+    /* 当前容器的右括号 */
+    Char _close{0};
+    /* 上一块是否结束在字符串内 */
+    uint64_t _string{0u};
+    /* 根结点结束的偏移 */
+    size_t _stop{0u};
+    uint64_t _objects[max_depth / 64u]{};
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_delimiter(Char c) noexcept {
+        switch (c) {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+            case ':':
+            case ',':
+            case '"':
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+                return True;
+            default:
+                return False;
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t _is_literal(Char const* p,
+                                               string::view<Char> literal) const noexcept {
+        auto stop = p + literal.size();
+        if (unlikely(stop > _end || !equal(literal.begin(), literal.end(), p))) {
+            return False;
+        }
+        return stop == _end || _is_delimiter(*stop);
+    }
+
+    NODISCARD ALWAYS_INLINE static uint64_t _low_bits(size_t size) noexcept {
+        return size < 64u ? (1ULL << size) - 1u : ~0ULL;
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_digit(Char c) noexcept {
+        return c >= '0' && c <= '9';
+    }
+
+    /* -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, 之后必须是分隔符 */
+    NODISCARD ALWAYS_INLINE bool_t _is_number(Char const* p) const noexcept {
+        auto digits = [&]() {
+            auto first = p;
+            while (p < _end && _is_digit(*p)) {
+                ++p;
+            }
+            return p != first;
+        };
+        if (*p == '-') {
+            ++p;
+        }
+        if (p < _end && *p == '0') {
+            ++p;
+        } else if (!digits()) {
+            return False;
+        }
+        if (p < _end && *p == '.') {
+            ++p;
+            if (!digits()) {
+                return False;
+            }
+        }
+        if (p < _end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            if (p < _end && (*p == '+' || *p == '-')) {
+                ++p;
+            }
+            if (!digits()) {
+                return False;
+            }
+        }
+        return p == _end || _is_delimiter(*p);
+    }
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_hex(Char c) noexcept {
+        return _is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    /* p 指向反斜杠之后的字符: "\/bfnrt 之一, 或 u 加 4 位十六进制数 */
+    NODISCARD ALWAYS_INLINE bool_t _is_escape(Char const* p) const noexcept {
+        switch (*p) {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                return True;
+            case 'u':
+                return _end - p > 4 && _is_hex(p[1]) && _is_hex(p[2]) && _is_hex(p[3]) &&
+                       _is_hex(p[4]);
+            default:
+                return False;
+        }
+    }
+
+    /* 返回不合法的转义字符的位图; 输入末尾的反斜杠由缺少右引号报告 */
+    NODISCARD ALWAYS_INLINE uint64_t _escapes(uint64_t escaped, size_t offset) const noexcept {
+        uint64_t invalid{0u};
+        for (; escaped != 0u; escaped &= escaped - 1u) {
+            auto i = size_t(__builtin_ctzll(escaped));
+            auto p = _begin + offset + i;
+            if (p < _end && unlikely(!_is_escape(p))) {
+                invalid |= 1ULL << i;
+            }
+        }
+        return invalid;
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t _in_object() const noexcept { return _close == '}'; }
+
+    NODISCARD ALWAYS_INLINE state _fail(error code, size_t offset) noexcept {
+        _error = int32_t(code);
+        _offset = offset;
+        return state::done;
+    }
+
+    NODISCARD ALWAYS_INLINE state _push(bool_t is_object, size_t offset) noexcept {
+        if (unlikely(_depth == max_depth)) {
+            return _fail(error::depth_exceeded, offset);
+        }
+        auto bit = uint64_t(1u) << (_depth % 64u);
+        auto& word = _objects[_depth / 64u];
+        word = is_object ? (word | bit) : (word & ~bit);
+        ++_depth;
+        _close = is_object ? '}' : ']';
+        return state::first;
+    }
+
+    NODISCARD ALWAYS_INLINE state _pop(size_t offset) noexcept {
+        if (--_depth == 0u) {
+            _stop = offset + 1u;
+            return state::done;
+        }
+        auto top = _depth - 1u;
+        _close = (_objects[top / 64u] >> (top % 64u)) & 1u ? '}' : ']';
+        return state::next;
+    }
+
+    NODISCARD ALWAYS_INLINE state _value(Char c, size_t offset) noexcept {
+        auto p = _begin + offset;
+        switch (c) {
+            case '"':
+                return state::next;
+            case '{':
+            case '[':
+                return _push(c == '{', offset);
+            case 'n':
+                return likely(_is_literal(p, string::null_str<Char>))
+                           ? state::next
+                           : _fail(error::invalid_null, offset);
+            case 't':
+                return likely(_is_literal(p, string::true_str<Char>))
+                           ? state::next
+                           : _fail(error::invalid_boolean, offset);
+            case 'f':
+                return likely(_is_literal(p, string::false_str<Char>))
+                           ? state::next
+                           : _fail(error::invalid_boolean, offset);
+            default:
+                if (unlikely(c != '-' && !_is_digit(c))) {
+                    return _fail(error::unknown, offset);
+                }
+                return likely(_is_number(p)) ? state::next : _fail(error::invalid_number, offset);
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE state _step(state current, size_t offset) noexcept {
+        auto c = _begin[offset];
+        switch (current) {
+            case state::root:
+                return likely(c == '{' || c == '[') ? _push(c == '{', offset)
+                                                    : _fail(error::missing_left_brace, offset);
+            case state::first:
+                if (c == _close) {
+                    return _pop(offset);
+                }
+                if (!_in_object()) {
+                    return _value(c, offset);
+                }
+                return likely(c == '"') ? state::colon : _fail(error::missing_left_quote, offset);
+            case state::next:
+                if (c == _close) {
+                    return _pop(offset);
+                }
+                if (unlikely(c != ',')) {
+                    return _fail(error::missing_comma, offset);
+                }
+                return _in_object() ? state::key : state::value;
+            case state::key:
+                return likely(c == '"') ? state::colon : _fail(error::missing_left_quote, offset);
+            case state::colon:
+                return likely(c == ':') ? state::value : _fail(error::missing_colon, offset);
+            case state::value:
+                return _value(c, offset);
+            default:
+                return state::done;
+        }
+    }
+
+    ALWAYS_INLINE void _block(uint8_t const* p, size_t offset, simd::scanner& scanner) noexcept {
+        uint64_t string, escaped;
+        auto bits = scanner.next(p, &string, &escaped);
+        /* 字符串内未转义的控制字符与不合法的转义; 先处理它们之前的结构字符, 报告最早的错误 */
+        uint64_t control = simd::control(p) & string;
+        escaped &= string;
+        uint64_t invalid = escaped != 0u ? _escapes(escaped, offset) : 0u;
+        uint64_t bad = control | invalid;
+        /* 右引号不参与校验: 字符串的合法性由第一阶段保证 */
+        bits &= ~(((string << 1) | _string) & ~string);
+        _string = string >> 63;
+        if (unlikely(bad != 0u)) {
+            bits &= _low_bits(size_t(__builtin_ctzll(bad)));
+        }
+        auto current = _state;
+        while (bits != 0u && current != state::done) {
+            current = _step(current, offset + size_t(__builtin_ctzll(bits)));
+            bits &= bits - 1u;
+        }
+        if (unlikely(bad != 0u && current != state::done)) {
+            auto pos = offset + size_t(__builtin_ctzll(bad));
+            if (control & (bad & (0u - bad))) {
+                current = _fail(error::control_character, pos);
+            } else {
+                /* 报告反斜杠的偏移 */
+                current = _fail(_begin[pos] == 'u' ? error::invalid_unicode : error::invalid_escape,
+                                pos - 1u);
+            }
+        }
+        _state = current;
+    }
+
+    /* 根结点之后只允许空白 */
+    ALWAYS_INLINE void _trailing() noexcept {
+        for (auto p = _begin + _stop; p < _end; ++p) {
+            if (unlikely(*p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')) {
+                _state = _fail(error::trailing_characters, size_t(p - _begin));
+                break;
+            }
+        }
+    }
+
+    /* 结构字符读完时仍未结束 */
+    ALWAYS_INLINE void _finish(size_t size) noexcept {
+        switch (_state) {
+            case state::done:
+                break;
+            case state::root:
+                _state = _fail(error::missing_left_brace, size);
+                break;
+            case state::colon:
+                _state = _fail(error::missing_colon, size);
+                break;
+            default:
+                _state = _fail(error::missing_right_brace, size);
+        }
+    }
+
+public:
+    ALWAYS_INLINE validator(Char const* begin, Char const* end) noexcept
+            : _begin(begin), _end(end) {}
+
+    /* 返回 0 或 error, 出错的字节偏移见 offset() */
+    int32_t operator()() noexcept {
+        auto first = (uint8_t const*)(_begin);
+        auto size = size_t(_end - _begin);
+
+        simd::scanner scanner;
+        size_t offset{0u};
+        for (; offset + simd::block_size <= size; offset += simd::block_size) {
+            _block(first + offset, offset, scanner);
+        }
+        if (offset < size) {
+            alignas(32) uint8_t tail[simd::block_size];
+            _memset_(tail, ' ', sizeof(tail));
+            _memcpy_(tail, first + offset, size - offset);
+            _block(tail, offset, scanner);
+        }
+
+        if (_state == state::done) {
+            if (_error == 0) {
+                _trailing();
+            }
+        } else if (unlikely(scanner.in_string())) {
+            _state = _fail(error::missing_right_quote, size);
+        }
+        _finish(size);
+        return _error;
+    }
+
+    NODISCARD ALWAYS_INLINE size_t offset() const noexcept { return _offset; }
+};
+
+template <class Char>
+NODISCARD ALWAYS_INLINE int32_t __validate(Char const* begin, Char const* end, size_t* offset) {
+    validator<Char> validator(begin, end);
+    int32_t result = validator();
+    if (offset != nullptr) {
+        *offset = validator.offset();
+    }
+    return result;
+}
+
+/* 只检查 [begin, end) 是否为合法的 JSON, offset 非空时写入出错的字节偏移 */
+template <class Iter1, class Iter2>
+NODISCARD ALWAYS_INLINE int32_t validate(Iter1 begin, Iter2 end, size_t* offset = nullptr) {
+    auto first = &*begin;
+    return __validate(first, first + (end - begin), offset);
+}
+
+/* writer 的输出端只需提供 write(Char const*, size_t) */
+template <class Func>
+class callback_sink final : public object {
+protected:
+    Func _func;
+
+public:
+    ALWAYS_INLINE explicit callback_sink(Func func) : _func(qlib::move(func)) {}
+
+    template <class Char>
+    ALWAYS_INLINE void write(Char const* data, size_t size) {
+        _func(data, size);
+    }
+};
+
+template <class Func>
+NODISCARD ALWAYS_INLINE auto make_sink(Func func) {
+    return callback_sink<Func>(qlib::move(func));
+}
+
+#if defined(_STDIO_H) || defined(_GLIBCXX_CSTDIO) || defined(_INC_STDIO)
+class file_sink final : public object {
+protected:
+    FILE* _file;
+
+public:
+    ALWAYS_INLINE explicit file_sink(FILE* file) noexcept : _file(file) {}
+
+    template <class Char>
+    ALWAYS_INLINE void write(Char const* data, size_t size) {
+        throw_if(fwrite(data, sizeof(Char), size, _file) != size, "write failed");
+    }
+};
+#endif
+
+#if defined(_UNISTD_H)
+class fd_sink final : public object {
+protected:
+    int32_t _fd;
+
+public:
+    ALWAYS_INLINE explicit fd_sink(int32_t fd) noexcept : _fd(fd) {}
+
+    template <class Char>
+    ALWAYS_INLINE void write(Char const* data, size_t size) {
+        auto first = (char const*)(data);
+        size *= sizeof(Char);
+        while (size > 0u) {
+            auto n = ::write(_fd, first, size);
+            throw_if(n <= 0, "write failed");
+            first += n;
+            size -= size_t(n);
+        }
+    }
+};
+#endif
+
+#if defined(_GLIBCXX_OSTREAM) || defined(__MSVC_OSTREAM_HPP)
+template <class Char>
+class ostream_sink final : public object {
+protected:
+    std::basic_ostream<Char>& _stream;
+
+public:
+    ALWAYS_INLINE explicit ostream_sink(std::basic_ostream<Char>& stream) noexcept
+            : _stream(stream) {}
+
+    ALWAYS_INLINE void write(Char const* data, size_t size) {
+        _stream.write(data, std::streamsize(size));
+        throw_if(!_stream, "write failed");
+    }
+};
+#endif
+
+/* 流式序列化: 输出先写入固定大小的缓冲区, 写满即刷新到 sink, 内存占用与文档大小无关 */
+template <class Sink, class Char = char, class Allocator = new_allocator_t>
+class writer final : public traits<Allocator>::reference {
+public:
+    using base = typename traits<Allocator>::reference;
+    using self = writer;
+    using sink_type = Sink;
+    using char_type = Char;
+    using allocator_type = Allocator;
+    using size_type = uint32_t;
+    using string_view_t = string::view<Char>;
+    constexpr static size_type default_capacity = 64u * 1024u;
+
+protected:
+    sink_type _sink;
+    Char* _impl{nullptr};
+    size_type _size{0u};
+    size_type _capacity{0u};
+    uint32_t _indent{0u};
+    uint32_t _depth{0u};
+    bool_t _first{True};
+    bool_t _key{False};
+
+    NODISCARD ALWAYS_INLINE allocator_type& _allocator() noexcept {
+        return static_cast<base&>(*this);
+    }
+
+    ALWAYS_INLINE void _put(Char c) {
+        if (unlikely(_size == _capacity)) {
+            flush();
+        }
+        _impl[_size++] = c;
+    }
+
+    ALWAYS_INLINE void _append(Char const* data, size_t size) {
+        if (unlikely(size > size_t(_capacity - _size))) {
+            flush();
+            if (size >= _capacity) {
+                _sink.write(data, size);
+                return;
+            }
+        }
+        qlib::copy(data, data + size, _impl + _size);
+        _size += size_type(size);
+    }
+
+    ALWAYS_INLINE void _newline() {
+        _put('\n');
+        for (uint32_t i = _depth * _indent; i > 0u; --i) {
+            _put(' ');
+        }
+    }
+
+    /* 值之前的分隔符: 键之后不需要, 顶层的多个值按行分隔, 其余情况补逗号与缩进 */
+    ALWAYS_INLINE void _prefix() {
+        if (_key) {
+            _key = False;
+            return;
+        }
+        if (!_first) {
+            _put(_depth == 0u ? '\n' : ',');
+        }
+        _first = False;
+        if (_indent != 0u && _depth != 0u) {
+            _newline();
+        }
+    }
+
+    ALWAYS_INLINE self& _open(Char c) {
+        _prefix();
+        _put(c);
+        ++_depth;
+        _first = True;
+        return *this;
+    }
+
+    ALWAYS_INLINE self& _close(Char c) {
+        throw_if(_depth == 0u || _key, "unbalanced");
+        --_depth;
+        if (_indent != 0u && !_first) {
+            _newline();
+        }
+        _put(c);
+        _first = False;
+        return *this;
+    }
+
+    ALWAYS_INLINE void _quoted(string_view_t s) {
+        auto first = s.begin();
+        auto last = s.end();
+        _put('"');
+        while (first < last) {
+            auto n = __escape_prefix(first, last);
+            _append(first, n);
+            first += n;
+            if (first == last) {
+                break;
+            }
+            Char s[6]{};
+            _append(s, __escape_sequence(*first++, s));
+        }
+        _put('"');
+    }
+
+    /* 键已是转义后的原文 */
+    ALWAYS_INLINE void _raw_key(string_view_t key) {
+        _prefix();
+        _put('"');
+        _append(key.data(), key.size());
+        _put('"');
+        _put(':');
+        if (_indent != 0u) {
+            _put(' ');
+        }
+        _key = True;
+    }
+
+public:
+    writer(self const&) = delete;
+    self& operator=(self const&) = delete;
+
+    /* indent 为 0 时输出紧凑格式, 否则按 indent 个空格缩进 */
+    ALWAYS_INLINE explicit writer(sink_type sink,
+                                  uint32_t indent = 0u,
+                                  size_type capacity = default_capacity)
+            : _sink(qlib::move(sink)), _impl(_allocator().template allocate<Char>(capacity)),
+              _capacity(capacity), _indent(indent) {
+        throw_if(capacity == 0u, "invalid capacity");
+    }
+
+    ALWAYS_INLINE writer(sink_type sink,
+                         uint32_t indent,
+                         size_type capacity,
+                         allocator_type& allocator)
+            : base(allocator), _sink(qlib::move(sink)),
+              _impl(_allocator().template allocate<Char>(capacity)), _capacity(capacity),
+              _indent(indent) {
+        throw_if(capacity == 0u, "invalid capacity");
+    }
+
+    ALWAYS_INLINE ~writer() {
+        try {
+            flush();
+        } catch (exception const& _) {
+        }
+        _allocator().template deallocate<Char>(_impl, _capacity);
+        _impl = nullptr;
+    }
+
+    ALWAYS_INLINE void flush() {
+        if (_size != 0u) {
+            auto size = _size;
+            _size = 0u;
+            _sink.write(_impl, size);
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE sink_type& sink() noexcept { return _sink; }
+
+    ALWAYS_INLINE self& begin_object() { return _open('{'); }
+    ALWAYS_INLINE self& end_object() { return _close('}'); }
+    ALWAYS_INLINE self& begin_array() { return _open('['); }
+    ALWAYS_INLINE self& end_array() { return _close(']'); }
+
+    ALWAYS_INLINE self& key(string_view_t key) {
+        _prefix();
+        _quoted(key);
+        _put(':');
+        if (_indent != 0u) {
+            _put(' ');
+        }
+        _key = True;
+        return *this;
+    }
+
+    ALWAYS_INLINE self& str(string_view_t s) {
+        _prefix();
+        _quoted(s);
+        return *this;
+    }
+
+    /* 字符串已是转义后的原文, 例如 json_view_t 中的字符串 */
+    ALWAYS_INLINE self& escaped(string_view_t s) {
+        _prefix();
+        _put('"');
+        _append(s.data(), s.size());
+        _put('"');
+        return *this;
+    }
+
+    template <class T>
+    ALWAYS_INLINE enable_if_t<is_number_v<T>, self&> number(T value) {
+        Char s[32];
+        auto last = string::to_chars(s, s + 32, value);
+        _prefix();
+        _append(s, size_t(last - s));
+        return *this;
+    }
+
+    ALWAYS_INLINE self& boolean(bool_t value) {
+        return raw(value ? string::true_str<Char> : string::false_str<Char>);
+    }
+
+    ALWAYS_INLINE self& null() { return raw(string::null_str<Char>); }
+
+    /* 原样写入一个已序列化的值 */
+    ALWAYS_INLINE self& raw(string_view_t s) {
+        _prefix();
+        _append(s.data(), s.size());
+        return *this;
+    }
+
+    template <memory_policy Policy, class A>
+    self& write(json::value<Char, Policy, A> const& node) {
+        if (_indent == 0u) {
+            _prefix();
+            node.to(*this);
+            return *this;
+        }
+        switch (node.type()) {
+            case value_enum::object: {
+                begin_object();
+                for (auto& item : node.object()) {
+                    _raw_key(item.key);
+                    write(item.value);
+                }
+                end_object();
+                break;
+            }
+            case value_enum::array: {
+                begin_array();
+                for (auto& item : node.array()) {
+                    write(item);
+                }
+                end_array();
+                break;
+            }
+            default: {
+                _prefix();
+                node.to(*this);
+            }
+        }
+        return *this;
+    }
+
+    /* 作为 value::to 的输出流 */
+    ALWAYS_INLINE self& operator<<(string_view_t s) {
+        _append(s.data(), s.size());
+        return *this;
+    }
+};
+
+/* 结构体绑定: 特化 binding<T>, 在 visit 中按顺序列出键与成员, 同一份映射同时驱动 decode 与 encode.
+ *
+ *   template <>
+ *   struct json::binding<point> {
+ *       template <class T, class Func>
+ *       static void visit(T& value, Func&& func) {
+ *           func("x", value.x);
+ *           func("y", value.y);
+ *       }
+ *   };
+ *
+ * 成员可以是数值, bool_t, string_t, string_view_t (指向输入, 保留转义), vector_t 与其他已绑定的结构体 */
+template <class T>
+struct binding;
+
+struct __binding_probe final {
+    template <class Member>
+    ALWAYS_INLINE void operator()(char const*, Member&) const noexcept {}
+};
+
+template <class T, class = void>
+struct is_bound : public false_type {};
+
+template <class T>
+struct is_bound<T, void_t<decltype(binding<T>::visit(declval<T&>(), __binding_probe{}))>>
+        : public true_type {};
+
+template <class T>
+constexpr static bool_t is_bound_v = is_bound<T>::value;
+
+/* 单遍下降直接填充结构体, 不构造 json::value; 未知的键整体跳过, 缺失的键保持原值 */
+template <class Char>
+class binder final : public object {
+public:
+    using self = binder;
+    using char_type = Char;
+    using string_view_t = string::view<Char>;
+    using string_t = string::value<Char>;
+
+protected:
+    Char const* _cur;
+    Char const* _end;
+
+    ALWAYS_INLINE void _skip_space() noexcept {
+        while (_cur < _end && (*_cur == ' ' || *_cur == '\t' || *_cur == '\n' || *_cur == '\r')) {
+            ++_cur;
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t _consume(Char c) noexcept {
+        _skip_space();
+        if (likely(_cur < _end && *_cur == c)) {
+            ++_cur;
+            return True;
+        }
+        return False;
+    }
+
+    template <class T = Char>
+    NODISCARD ALWAYS_INLINE static enable_if_t<sizeof(T) == 1u, size_t> _plain_prefix(
+        Char const* first, Char const* last) noexcept {
+        return simd::escape_prefix((uint8_t const*)(first), (uint8_t const*)(last));
+    }
+
+    template <class T = Char>
+    NODISCARD ALWAYS_INLINE static enable_if_t<sizeof(T) != 1u, size_t> _plain_prefix(
+        Char const*, Char const*) noexcept {
+        return 0u;
+    }
+
+    /* 返回引号内的原文 */
+    NODISCARD ALWAYS_INLINE int32_t _string(string_view_t& text) noexcept {
+        if (unlikely(!_consume('"'))) {
+            return int32_t(error::missing_left_quote);
+        }
+        auto first = _cur;
+        while (_cur < _end) {
+            _cur += _plain_prefix(_cur, _end);
+            if (_cur >= _end || *_cur == '"') {
+                break;
+            }
+            _cur += (*_cur == '\\') ? 2 : 1;
+        }
+        if (unlikely(_cur >= _end)) {
+            return int32_t(error::missing_right_quote);
+        }
+        text = string_view_t(first, _cur++);
+        return 0;
+    }
+
+    /* 用结构字符位图跳过整个容器, 字符串内的括号已被排除 */
+    template <class T = Char>
+    NODISCARD enable_if_t<sizeof(T) == 1u, Char const*> _skip_container() noexcept {
+        auto first = (uint8_t const*)(_cur);
+        auto size = size_t(_end - _cur);
+        simd::scanner scanner;
+        uint32_t depth{0u};
+        alignas(32) uint8_t tail[simd::block_size];
+        for (size_t offset = 0u; offset < size; offset += simd::block_size) {
+            auto block = first + offset;
+            if (offset + simd::block_size > size) {
+                _memset_(tail, ' ', sizeof(tail));
+                _memcpy_(tail, block, size - offset);
+                block = tail;
+            }
+            auto bits = scanner.next(block);
+            while (bits != 0u) {
+                auto i = __builtin_ctzll(bits);
+                bits &= bits - 1u;
+                auto c = block[i] | 0x20u;
+                if (c == '{') {
+                    ++depth;
+                } else if (c == '}' && --depth == 0u) {
+                    return _cur + offset + i + 1u;
+                }
+            }
+        }
+        return _end;
+    }
+
+    template <class T = Char>
+    NODISCARD ALWAYS_INLINE enable_if_t<sizeof(T) != 1u, Char const*> _skip_container() noexcept {
+        return document_view<Char>(_cur, _end).raw().end();
+    }
+
+    NODISCARD ALWAYS_INLINE int32_t _skip() noexcept {
+        _skip_space();
+        if (unlikely(_cur == _end)) {
+            return int32_t(error::unknown);
+        }
+        switch (*_cur) {
+            case '"': {
+                string_view_t text;
+                return _string(text);
+            }
+            case '{':
+            case '[': {
+                _cur = _skip_container();
+                return 0;
+            }
+            default: {
+                while (_cur < _end && *_cur != ',' && *_cur != '}' && *_cur != ']' &&
+                       *_cur != ' ' && *_cur != '\t' && *_cur != '\n' && *_cur != '\r') {
+                    ++_cur;
+                }
+                return 0;
+            }
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE int32_t _decode(bool_t& value) noexcept {
+        _skip_space();
+        value = _cur < _end && *_cur == 't';
+        string_view_t literal(value ? string::true_str<Char> : string::false_str<Char>);
+        if (unlikely(size_t(_end - _cur) < literal.size() ||
+                     string_view_t(_cur, _cur + literal.size()) != literal)) {
+            return int32_t(error::invalid_boolean);
+        }
+        _cur += literal.size();
+        return 0;
+    }
+
+    /* 数值格式错误时与 get<T>() 一致抛出异常 */
+    template <class T>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_number_v<T> && !is_same_v<T, bool_t>, int32_t> _decode(
+        T& value) {
+        _skip_space();
+        auto first = _cur;
+        while (_cur < _end && ((*_cur >= '0' && *_cur <= '9') || *_cur == '-' || *_cur == '+' ||
+                               *_cur == '.' || *_cur == 'e' || *_cur == 'E')) {
+            ++_cur;
+        }
+        if (unlikely(first == _cur)) {
+            return int32_t(error::unknown);
+        }
+        converter<T>::decode(value, first, _cur);
+        return 0;
+    }
+
+    NODISCARD ALWAYS_INLINE int32_t _decode(string_view_t& value) noexcept {
+        return _string(value);
+    }
+
+    NODISCARD ALWAYS_INLINE int32_t _decode(string_t& value) {
+        string_view_t text;
+        int32_t result = _string(text);
+        if (likely(result == 0)) {
+            value = json::value<Char, view>(text).template get<string_t>();
+        }
+        return result;
+    }
+
+    template <class T, class Allocator>
+    NODISCARD int32_t _decode(vector::value<T, Allocator>& value) {
+        if (unlikely(!_consume('['))) {
+            return int32_t(error::missing_left_brace);
+        }
+        value.resize(0u);
+        if (_consume(']')) {
+            return 0;
+        }
+        do {
+            value.emplace_back();
+            int32_t result = _decode(value.back());
+            if (unlikely(result != 0)) {
+                return result;
+            }
+        } while (_consume(','));
+        return _consume(']') ? 0 : int32_t(error::missing_right_brace);
+    }
+
+    template <class T>
+    NODISCARD enable_if_t<is_bound_v<T>, int32_t> _decode(T& value) {
+        if (unlikely(!_consume('{'))) {
+            return int32_t(error::missing_left_brace);
+        }
+        if (_consume('}')) {
+            return 0;
+        }
+        do {
+            string_view_t key;
+            int32_t result = _string(key);
+            if (unlikely(result != 0)) {
+                return result;
+            }
+            if (unlikely(!_consume(':'))) {
+                return int32_t(error::missing_colon);
+            }
+            bool_t found{False};
+            binding<T>::visit(value, [&](char const* name, auto& member) {
+                if (!found && key == string_view_t(name)) {
+                    found = True;
+                    result = _decode(member);
+                }
+            });
+            if (!found) {
+                result = _skip();
+            }
+            if (unlikely(result != 0)) {
+                return result;
+            }
+        } while (_consume(','));
+        return _consume('}') ? 0 : int32_t(error::missing_right_brace);
+    }
+
+public:
+    ALWAYS_INLINE binder(Char const* begin, Char const* end) noexcept : _cur(begin), _end(end) {}
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE int32_t operator()(T& value) {
+        int32_t result = _decode(value);
+        _skip_space();
+        if (result == 0 && _cur != _end) {
+            result = int32_t(error::unknown);
+        }
+        return result;
+    }
+};
+
+template <class T, class Iter1, class Iter2>
+ALWAYS_INLINE int32_t decode(T* value, Iter1 begin, Iter2 end) {
+    static_assert(is_bound_v<T>, "json::binding<T> is not specialized");
+    auto first = &*begin;
+    using char_type = remove_cvref_t<decltype(*first)>;
+    return binder<char_type>(first, first + (end - begin))(*value);
+}
+
+template <class Sink, class Char, class Allocator>
+ALWAYS_INLINE void __encode(writer<Sink, Char, Allocator>& out, bool_t value) {
+    out.boolean(value);
+}
+
+template <class Sink, class Char, class Allocator, class T>
+ALWAYS_INLINE enable_if_t<is_number_v<T> && !is_same_v<T, bool_t>> __encode(
+    writer<Sink, Char, Allocator>& out, T value) {
+    out.number(value);
+}
+
+/* string_view_t 成员是转义后的原文 */
+template <class Sink, class Char, class Allocator>
+ALWAYS_INLINE void __encode(writer<Sink, Char, Allocator>& out, string::view<Char> value) {
+    out.escaped(value);
+}
+
+template <class Sink, class Char, class Allocator, class A>
+ALWAYS_INLINE void __encode(writer<Sink, Char, Allocator>& out,
+                            string::value<Char, A> const& value) {
+    out.str(string::view<Char>(value.begin(), value.end()));
+}
+
+template <class Sink, class Char, class Allocator, class T>
+enable_if_t<is_bound_v<T>> __encode(writer<Sink, Char, Allocator>& out, T const& value);
+
+template <class Sink, class Char, class Allocator, class T, class A>
+void __encode(writer<Sink, Char, Allocator>& out, vector::value<T, A> const& value) {
+    out.begin_array();
+    for (auto& item : value) {
+        __encode(out, item);
+    }
+    out.end_array();
+}
+
+template <class Sink, class Char, class Allocator, class T>
+enable_if_t<is_bound_v<T>> __encode(writer<Sink, Char, Allocator>& out, T const& value) {
+    out.begin_object();
+    binding<T>::visit(value, [&out](char const* name, auto const& member) {
+        out.key(string::view<Char>(name));
+        __encode(out, member);
+    });
+    out.end_object();
+}
+
+/* 按绑定的成员顺序输出, 格式由 writer 的 indent 决定 */
+template <class Sink, class Char, class Allocator, class T>
+ALWAYS_INLINE writer<Sink, Char, Allocator>& encode(writer<Sink, Char, Allocator>& out,
+                                                    T const& value) {
+    static_assert(is_bound_v<T>, "json::binding<T> is not specialized");
+    __encode(out, value);
+    return out;
+}
+
+/* NDJSON: 每行一个文档, 空行跳过. 输入按行对齐切块, 每块使用独立的分配器, 可多线程解析 */
+template <class Json>
+class lines_reader final : public object {
+public:
+    using self = lines_reader;
+    using json_type = Json;
+    using char_type = typename json_type::char_type;
+    using allocator_type = typename json_type::allocator_type;
+    using string_view_t = string::view<char_type>;
+    using size_type = size_t;
+    constexpr static size_type default_chunk_size = 1u << 20;
+
+    /* value 的内存属于所在块, 只在回调期间有效 */
+    struct document final {
+        size_type line;
+        int32_t result;
+        string_view_t text;
+        json_type value;
+    };
+
+protected:
+    struct chunk final {
+        char_type const* begin;
+        char_type const* end;
+        size_type line;
+    };
+
+    /* 一个块的解析结果, 交付后连同分配器整体释放 */
+    struct batch final {
+        allocator_type allocator;
+        vector_t<document> documents;
+    };
+
+    vector_t<chunk> _chunks;
+    parse_option _options{parse_default};
+    intern_table<char_type>* _intern{nullptr};
+
+    NODISCARD ALWAYS_INLINE static bool_t _is_space(char_type c) noexcept {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    template <class T = json_type>
+    NODISCARD ALWAYS_INLINE enable_if_t<is_same_v<typename T::key_type, string_view_t>, int32_t>
+    _parse_line(json_type* json, char_type const* first, char_type const* last) const {
+        return _intern != nullptr ? parse(json, first, last, _options, *_intern)
+                                  : parse(json, first, last, _options);
+    }
+
+    template <class T = json_type>
+    NODISCARD ALWAYS_INLINE enable_if_t<!is_same_v<typename T::key_type, string_view_t>, int32_t>
+    _parse_line(json_type* json, char_type const* first, char_type const* last) const {
+        return parse(json, first, last, _options);
+    }
+
+    template <class Func>
+    ALWAYS_INLINE void _parse(chunk const& chunk, allocator_type& allocator, Func&& func) const {
+        auto line = chunk.line;
+        for (auto first = chunk.begin; first < chunk.end; ++line) {
+            auto last = first;
+            while (last < chunk.end && *last != '\n') {
+                ++last;
+            }
+            auto stop = (last > first && *(last - 1) == '\r') ? last - 1 : last;
+            auto p = first;
+            while (p < stop && _is_space(*p)) {
+                ++p;
+            }
+            if (p < stop) {
+                document doc{line, 0, string_view_t(first, stop), json_type(allocator)};
+                doc.result = _parse_line(&doc.value, first, stop);
+                func(doc);
+            }
+            first = last + 1;
+        }
+    }
+
+#if (defined(_GLIBCXX_THREAD) && defined(_GLIBCXX_MUTEX_H) &&                    \
+     defined(_GLIBCXX_CONDITION_VARIABLE)) ||                                   \
+    (defined(_MSC_VER) && defined(_THREAD_) && defined(_MUTEX_) && defined(_CONDITION_VARIABLE_))
+    /* 持有一个块的结果, 析构时释放; 回调抛出异常时块也不会泄漏 */
+    class batch_owner final : public object {
+    protected:
+        new_allocator_t& _allocator;
+        batch* _batch;
+
+    public:
+        ALWAYS_INLINE batch_owner(new_allocator_t& allocator, batch* value) noexcept
+                : _allocator(allocator), _batch(value) {}
+        batch_owner(batch_owner const&) = delete;
+        batch_owner& operator=(batch_owner const&) = delete;
+
+        ALWAYS_INLINE ~batch_owner() {
+            if (_batch != nullptr) {
+                _allocator.destroy(_batch);
+                _allocator.template deallocate<batch>(_batch, 1u);
+            }
+        }
+
+        NODISCARD ALWAYS_INLINE batch* get() const noexcept { return _batch; }
+
+        NODISCARD ALWAYS_INLINE batch* release() noexcept {
+            auto result = _batch;
+            _batch = nullptr;
+            return result;
+        }
+    };
+
+    template <class Func>
+    void _parallel(Func& func, uint32_t threads, bool_t ordered) {
+        new_allocator_t allocator;
+        size_type size = _chunks.size();
+        auto batches = allocator.template allocate<batch*>(size);
+        for (size_type i = 0u; i < size; ++i) {
+            batches[i] = nullptr;
+        }
+        threads = size < threads ? uint32_t(size) : threads;
+        /* ordered 时已完成但未交付的块最多 window 个, 超出时工作线程等待 */
+        size_type window = ordered ? size_type(threads) * 2u : size;
+
+        std::mutex mutex;
+        std::mutex deliver_mutex;
+        std::condition_variable released;
+        std::exception_ptr error;
+        size_type next{0u};
+        size_type delivered{0u};
+        /* 已交付的块数, 由 mutex 保护; delivered 由 deliver_mutex 保护 */
+        size_type done{0u};
+
+        auto deliver = [&](size_type index) {
+            batch_owner current(allocator, batches[index]);
+            batches[index] = nullptr;
+            for (auto& doc : current.get()->documents) {
+                func(doc);
+            }
+        };
+
+        auto fail = [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            released.notify_all();
+        };
+
+        auto worker = [&]() {
+            try {
+                for (;;) {
+                    size_type index;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        released.wait(lock, [&]() {
+                            return next == size || error || next < done + window;
+                        });
+                        if (next == size || error) {
+                            break;
+                        }
+                        index = next++;
+                    }
+
+                    batch_owner current(allocator, allocator.template allocate<batch>(1u));
+                    allocator.construct(current.get());
+                    auto documents = &current.get()->documents;
+                    _parse(_chunks[index], current.get()->allocator, [documents](document& doc) {
+                        documents->emplace_back(qlib::move(doc));
+                    });
+
+                    /* 回调在锁内串行调用; ordered 时只交付已连续完成的块 */
+                    std::lock_guard<std::mutex> lock(deliver_mutex);
+                    batches[index] = current.release();
+                    if (ordered) {
+                        while (delivered < size && batches[delivered] != nullptr) {
+                            deliver(delivered++);
+                        }
+                        std::lock_guard<std::mutex> guard(mutex);
+                        done = delivered;
+                        released.notify_all();
+                    } else {
+                        deliver(index);
+                    }
+                }
+            } catch (...) {
+                fail();
+            }
+        };
+
+        vector_t<std::thread> pool(threads);
+        for (uint32_t i = 1u; i < threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        for (size_type i = 0u; i < size; ++i) {
+            batch_owner current(allocator, batches[i]);
+        }
+        allocator.template deallocate<batch*>(batches, size);
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+#endif
+
+public:
+    template <class Iter1, class Iter2>
+    ALWAYS_INLINE lines_reader(Iter1 begin,
+                               Iter2 end,
+                               parse_option options = parse_default,
+                               size_type chunk_size = default_chunk_size)
+            : _options(options) {
+        throw_if(chunk_size == 0u, "invalid chunk size");
+        auto first = &*begin;
+        auto last = first + (end - begin);
+        size_type line = 1u;
+        while (first < last) {
+            auto stop = size_type(last - first) > chunk_size ? first + chunk_size : last;
+            while (stop < last && *(stop - 1) != '\n') {
+                ++stop;
+            }
+            _chunks.emplace_back(chunk{first, stop, line});
+            for (; first < stop; ++first) {
+                line += (*first == '\n');
+            }
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE size_type chunks() const noexcept { return _chunks.size(); }
+
+    /* 各块的文档共用 table 中的键, 键的地址在块释放后仍然有效; 多线程解析时 table 同样可共享 */
+    ALWAYS_INLINE void intern(intern_table<char_type>& table) noexcept {
+        static_assert(is_same_v<typename json_type::key_type, string_view_t>,
+                      "interned keys need the view policy");
+        _intern = &table;
+    }
+
+    /* func(document&); threads > 1 时需包含 <thread>, <mutex> 与 <condition_variable>,
+     * 否则退化为单线程. ordered 时未交付的块不超过 2 * threads 个 */
+    template <class Func>
+    void for_each(Func&& func, uint32_t threads = 1u, bool_t ordered = True) {
+#if (defined(_GLIBCXX_THREAD) && defined(_GLIBCXX_MUTEX_H) &&                    \
+     defined(_GLIBCXX_CONDITION_VARIABLE)) ||                                   \
+    (defined(_MSC_VER) && defined(_THREAD_) && defined(_MUTEX_) && defined(_CONDITION_VARIABLE_))
+        if (threads > 1u && _chunks.size() > 1u) {
+            _parallel(func, threads, ordered);
+            return;
+        }
+#endif
+        for (auto& chunk : _chunks) {
+            allocator_type allocator;
+            _parse(chunk, allocator, func);
+        }
+    }
+};
+
+/* 批量解析许多小文档: 常驻的有界线程池, 调用线程也参与解析; 每个线程有自己的分配器(arena)
+ * 与解析缓冲区, 线程之间只共享一个原子下标. 结果按输入顺序排列, 各自带错误码,
+ * 文档的内存在下一次 parse 时回收. threads > 1 时需包含 <thread>, <mutex> 与
+ * <condition_variable>, 否则退化为单线程 */
+template <class Json>
+class batch_parser final : public object {
+public:
+    using self = batch_parser;
+    using json_type = Json;
+    using char_type = typename json_type::char_type;
+    using allocator_type = typename json_type::allocator_type;
+    using string_view_t = string::view<char_type>;
+    using parser_type = parser<json_type>;
+    using size_type = size_t;
+    constexpr static size_type default_grain = 16u;
+
+    static_assert(!is_same_v<allocator_type, new_allocator_t>,
+                  "batch_parser needs resettable arena allocators (pool_allocator_t)");
+
+    struct document final {
+        int32_t result;
+        json_type value;
+    };
+
+protected:
+    struct worker final {
+        allocator_type allocator;
+        parser_type parser;
+        typename parser_type::layers_type layers;
+        structural_index<> index;
+        vector_t<uint32_t> sizes;
+        /* 相邻线程的数据不共享缓存行 */
+        uint8_t padding[64];
+
+        ALWAYS_INLINE explicit worker(parse_option options) : parser(16u, options), layers(16u) {}
+    };
+
+    new_allocator_t _allocator;
+    worker* _workers{nullptr};
+    uint32_t _threads{1u};
+    size_type _grain{default_grain};
+    vector_t<document> _documents;
+    string_view_t const* _inputs{nullptr};
+    size_type _size{0u};
+    size_type _next{0u};
+
+#if (defined(_GLIBCXX_THREAD) && defined(_GLIBCXX_MUTEX_H) &&                    \
+     defined(_GLIBCXX_CONDITION_VARIABLE)) ||                                   \
+    (defined(_MSC_VER) && defined(_THREAD_) && defined(_MUTEX_) && defined(_CONDITION_VARIABLE_))
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    std::exception_ptr _error;
+    size_type _generation{0u};
+    uint32_t _pending{0u};
+    bool_t _stop{False};
+    vector_t<std::thread> _pool;
+
+    void _loop(uint32_t id) {
+        size_type generation{0u};
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _start.wait(lock, [&]() { return _stop || _generation != generation; });
+                if (_stop) {
+                    break;
+                }
+                generation = _generation;
+            }
+            try {
+                _run(_workers[id]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error) {
+                    _error = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0u) {
+                _done.notify_one();
+            }
+        }
+    }
+#endif
+
+    /* 按 _grain 个一组领取输入; 上一次的文档与 arena 一起回收, 不逐个析构 */
+    void _run(worker& worker) {
+        worker.allocator.reset();
+        for (;;) {
+            auto first = __atomic_fetch_add(&_next, _grain, __ATOMIC_RELAXED);
+            if (first >= _size) {
+                break;
+            }
+            auto last = first + _grain < _size ? first + _grain : _size;
+            for (auto i = first; i < last; ++i) {
+                auto& doc = _documents[i];
+                auto& text = _inputs[i];
+                new (&doc.value) json_type(worker.allocator);
+                doc.result = worker.parser(&doc.value, text.begin(), text.end(), worker.layers,
+                                           worker.index, worker.sizes);
+            }
+        }
+    }
+
+    /* 多出的文档在各 arena 回收前析构, 留下的槽位由 _run 直接覆盖 */
+    void _resize(size_type size) {
+        while (_documents.size() > size) {
+            _documents.pop_back();
+        }
+        while (_documents.size() < size) {
+            _documents.emplace_back(document{0, json_type(_workers[0].allocator)});
+        }
+    }
+
+public:
+    explicit batch_parser(uint32_t threads = 1u,
+                          parse_option options = parse_default,
+                          size_type grain = default_grain)
+            : _threads(threads != 0u ? threads : 1u), _grain(grain != 0u ? grain : 1u) {
+#if !((defined(_GLIBCXX_THREAD) && defined(_GLIBCXX_MUTEX_H) &&                    \
+     defined(_GLIBCXX_CONDITION_VARIABLE)) ||                                   \
+    (defined(_MSC_VER) && defined(_THREAD_) && defined(_MUTEX_) && defined(_CONDITION_VARIABLE_)))
+        _threads = 1u;
+#endif
+        _workers = _allocator.template allocate<worker>(_threads);
+        for (uint32_t i = 0u; i < _threads; ++i) {
+            _allocator.construct(_workers + i, options);
+        }
+#if (defined(_GLIBCXX_THREAD) && defined(_GLIBCXX_MUTEX_H) &&                    \
+     defined(_GLIBCXX_CONDITION_VARIABLE)) ||                                   \
+    (defined(_MSC_VER) && defined(_THREAD_) && defined(_MUTEX_) && defined(_CONDITION_VARIABLE_))
+        _pool.reserve(_threads);
+        for (uint32_t i = 1u; i < _threads; ++i) {
+            _pool.emplace_back([this, i]() { _loop(i); });
+        }
+#endif
+    }
+
+    batch_parser(self const&) = delete;
+    self& operator=(self const&) = delete;
+
+    ~batch_parser() {
+        _documents.clear();
+#if (defined(_GLIBCXX_THREAD) && defined(_GLIBCXX_MUTEX_H) &&                    \
+     defined(_GLIBCXX_CONDITION_VARIABLE)) ||                                   \
+    (defined(_MSC_VER) && defined(_THREAD_) && defined(_MUTEX_) && defined(_CONDITION_VARIABLE_))
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = True;
+        }
+        _start.notify_all();
+        for (auto& thread : _pool) {
+            thread.join();
+        }
+#endif
+        for (uint32_t i = 0u; i < _threads; ++i) {
+            _allocator.destroy(_workers + i);
+        }
+        _allocator.template deallocate<worker>(_workers, _threads);
+    }
+
+    NODISCARD ALWAYS_INLINE uint32_t threads() const noexcept { return _threads; }
+
+    /* 返回的文档在下一次 parse 之前有效 */
+    vector_t<document> const& parse(string_view_t const* first, string_view_t const* last) {
+        auto size = size_type(last - first);
+        _resize(size);
+        _inputs = first;
+        _size = size;
+        _next = 0u;
+#if (defined(_GLIBCXX_THREAD) && defined(_GLIBCXX_MUTEX_H) &&                    \
+     defined(_GLIBCXX_CONDITION_VARIABLE)) ||                                   \
+    (defined(_MSC_VER) && defined(_THREAD_) && defined(_MUTEX_) && defined(_CONDITION_VARIABLE_))
+        if (_threads > 1u && size > _grain) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                ++_generation;
+                _pending = _threads - 1u;
+            }
+            _start.notify_all();
+            std::exception_ptr error;
+            try {
+                _run(_workers[0]);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this]() { return _pending == 0u; });
+            if (!error) {
+                error = _error;
+            }
+            _error = nullptr;
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return _documents;
+        }
+#endif
+        _run(_workers[0]);
+        return _documents;
+    }
+
+    NODISCARD ALWAYS_INLINE vector_t<document> const& documents() const noexcept {
+        return _documents;
+    }
+};
+
+/* 见 batch_parser */
+template <class Json>
+ALWAYS_INLINE vector_t<typename batch_parser<Json>::document> const& parse_batch(
+    batch_parser<Json>& batch,
+    string::view<typename Json::char_type> const* first,
+    string::view<typename Json::char_type> const* last) {
+    return batch.parse(first, last);
 }
 
 template <class OutStream, class Char, memory_policy Policy, class Allocator>
@@ -1234,5 +7575,9 @@ using json_t = json::value<char, json::copy>;
 using json_view_t = json::value<char, json::view>;
 using json_pool_t = json::value<char, json::copy, pool_allocator_t>;
 using json_view_pool_t = json::value<char, json::view, pool_allocator_t>;
+using json_tape_t = json::tape<char>;
+using json_compact_t = json::compact<char>;
+using json_intern_t = json::intern_table<char>;
+using json_frozen_t = json::frozen<char>;
 
 };  // namespace qlib
@@ -41,6 +41,55 @@ NODISCARD ALWAYS_INLINE CONSTEXPR static auto align_up(T1 size, T2 alignment) no
     return (size + (alignment - 1)) & ~(alignment - 1);
 }
 
+NODISCARD ALWAYS_INLINE static uint8_t byteswap(uint8_t value) noexcept { return value; }
+NODISCARD ALWAYS_INLINE static uint16_t byteswap(uint16_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap16(value);
+#elif defined(_MSC_VER) && (defined(_INC_STDLIB) || defined(_CSTDLIB_))
+    return _byteswap_ushort(value);
+#else
+    return uint16_t((value << 8) | (value >> 8));
+#endif
+}
+NODISCARD ALWAYS_INLINE static uint32_t byteswap(uint32_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(value);
+#elif defined(_MSC_VER) && (defined(_INC_STDLIB) || defined(_CSTDLIB_))
+    return _byteswap_ulong(value);
+#else
+    return (value << 24) | ((value << 8) & 0x00FF0000u) | ((value >> 8) & 0x0000FF00u) |
+           (value >> 24);
+#endif
+}
+NODISCARD ALWAYS_INLINE static uint64_t byteswap(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(value);
+#elif defined(_MSC_VER) && (defined(_INC_STDLIB) || defined(_CSTDLIB_))
+    return _byteswap_uint64(value);
+#else
+    return (uint64_t(byteswap(uint32_t(value))) << 32) | byteswap(uint32_t(value >> 32));
+#endif
+}
+
+/* 大端读写, 供 MessagePack/CBOR 等二进制格式使用 */
+template <class T>
+NODISCARD ALWAYS_INLINE static T load_big_endian(void const* p) noexcept {
+    T value;
+    _memcpy_(&value, p, sizeof(T));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = byteswap(value);
+#endif
+    return value;
+}
+
+template <class T>
+ALWAYS_INLINE static void store_big_endian(void* p, T value) noexcept {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = byteswap(value);
+#endif
+    _memcpy_(p, &value, sizeof(T));
+}
+
 class bad_alloc final : public exception {
 public:
     char const* what() const noexcept override { return "bad alloc"; }
@@ -98,24 +147,32 @@ protected:
 
     node* _list{nullptr};
 
-public:
-    ALWAYS_INLINE CONSTEXPR pool_allocator(size_type capacity = 64 * 1024) noexcept {
-        _list = (node*)base::allocate<uint8_t>(sizeof(node) + capacity);
-        _list->next = nullptr;
-        _list->data = (uint8_t*)_list + sizeof(node);
-        _list->used = 0u;
-        _list->capacity = capacity;
+    NODISCARD ALWAYS_INLINE node* _make(size_type capacity, node* next) noexcept {
+        auto result = (node*)base::allocate<uint8_t>(sizeof(node) + capacity);
+        result->next = next;
+        result->data = (uint8_t*)result + sizeof(node);
+        result->used = 0u;
+        result->capacity = capacity;
+        return result;
     }
 
-    ALWAYS_INLINE ~pool_allocator() noexcept {
+    ALWAYS_INLINE void _release() noexcept {
         node* cur = _list;
         while (cur != nullptr) {
             node* next = cur->next;
             base::deallocate<uint8_t>((uint8_t*)(cur), sizeof(node) + cur->capacity);
             cur = next;
         }
+        _list = nullptr;
     }
 
+public:
+    ALWAYS_INLINE pool_allocator(size_type capacity = 64 * 1024) noexcept {
+        _list = _make(capacity, nullptr);
+    }
+
+    ALWAYS_INLINE ~pool_allocator() noexcept { _release(); }
+
     template <class T>
     NODISCARD ALWAYS_INLINE CONSTEXPR T* allocate(size_type n) noexcept {
         static_assert(sizeof(T) > 0, "cannot allocate zero-sized object");
@@ -127,12 +184,7 @@ public:
             while (new_capacity < size) {
                 new_capacity *= 2;
             }
-            auto new_node = (node*)base::allocate<uint8_t>(sizeof(node) + new_capacity);
-            new_node->next = _list;
-            new_node->data = (uint8_t*)new_node + sizeof(node);
-            new_node->used = 0u;
-            new_node->capacity = new_capacity;
-            _list = new_node;
+            _list = _make(new_capacity, _list);
         }
 
         auto ptr = (T*)(_list->data + _list->used);
@@ -142,6 +194,34 @@ public:
 
     template <class T>
     ALWAYS_INLINE CONSTEXPR void deallocate(T* p ATTR_UNUSED, size_type n ATTR_UNUSED) noexcept {}
+
+    /* 已分配出去的字节数(含对齐), 用于统计文档的内存占用 */
+    NODISCARD ALWAYS_INLINE size_type used() const noexcept {
+        size_type result{0u};
+        for (auto cur = _list; cur != nullptr; cur = cur->next) {
+            result += cur->used;
+        }
+        return result;
+    }
+
+    /* 保留的字节数 */
+    NODISCARD ALWAYS_INLINE size_type capacity() const noexcept {
+        size_type result{0u};
+        for (auto cur = _list; cur != nullptr; cur = cur->next) {
+            result += cur->capacity;
+        }
+        return result;
+    }
+
+    /* 整体回收以便复用; 有多块时合并为一块, 下一轮同样大小的使用不再分配 */
+    ALWAYS_INLINE void reset() noexcept {
+        if (_list->next != nullptr) {
+            size_type capacity = this->capacity();
+            _release();
+            _list = _make(capacity, nullptr);
+        }
+        _list->used = 0u;
+    }
 };
 
 template <size_t Capacity>
@@ -168,6 +248,10 @@ public:
 
     template <class T>
     ALWAYS_INLINE CONSTEXPR void deallocate(T* p ATTR_UNUSED, uint64_t n ATTR_UNUSED) noexcept {}
+
+    NODISCARD ALWAYS_INLINE size_type used() const noexcept { return _used; }
+    NODISCARD ALWAYS_INLINE static constexpr size_type capacity() noexcept { return Capacity; }
+    ALWAYS_INLINE void reset() noexcept { _used = 0u; }
 };
 
 template <class _Tp>
@@ -0,0 +1 @@
+#include "qlib/msgpack.hpp"
@@ -0,0 +1,427 @@
+#ifndef QLIB_MSGPACK_HPP
+#define QLIB_MSGPACK_HPP
+
+#include "qlib/json.h"
+
+namespace qlib {
+
+namespace msgpack {
+
+using error = json::error;
+
+/* MessagePack 与 json::value 互转. 字符串在节点中保存为 JSON 转义后的原文:
+ * 解码时需要转义的字符串才会复制, view 策略下其余字符串与 bin 直接引用输入.
+ * bin 解码为 value_enum::binary; ext 与非字符串的键没有对应的 JSON 表示, 返回 invalid_binary */
+template <class Json>
+class parser final : public object {
+public:
+    using self = parser;
+    using json_type = Json;
+    using char_type = typename json_type::char_type;
+    using allocator_type = typename json_type::allocator_type;
+    using array_type = typename json_type::array_type;
+    using object_type = typename json_type::object_type;
+    using string_view_t = string::view<char_type>;
+    constexpr static uint32_t max_depth = 1024u;
+
+    static_assert(sizeof(char_type) == 1u, "msgpack only supports 8-bit characters");
+
+protected:
+    uint8_t const* _cur;
+    uint8_t const* _end;
+    allocator_type& _allocator;
+    uint32_t _depth{0u};
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE bool_t _read(T& value) noexcept {
+        if (unlikely(size_t(_end - _cur) < sizeof(T))) {
+            return False;
+        }
+        value = memory::load_big_endian<T>(_cur);
+        _cur += sizeof(T);
+        return True;
+    }
+
+    NODISCARD ALWAYS_INLINE bool_t _bytes(string_view_t& value, size_t size) noexcept {
+        if (unlikely(size_t(_end - _cur) < size)) {
+            return False;
+        }
+        value = string_view_t((char_type const*)(_cur), (char_type const*)(_cur + size));
+        _cur += size;
+        return True;
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE bool_t _size(uint32_t& size) noexcept {
+        T value;
+        if (unlikely(!_read(value))) {
+            return False;
+        }
+        size = uint32_t(value);
+        return True;
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE int32_t _number(json_type& value, T number) {
+        if (is_floating_point_v<T> && (_isnan_(float64_t(number)) || _isinf_(float64_t(number)))) {
+            /* JSON 不能表示 NaN 与 Inf */
+            value = json_type(_allocator);
+        } else {
+            value = json_type(number, _allocator);
+        }
+        return 0;
+    }
+
+    template <class T>
+    NODISCARD ALWAYS_INLINE int32_t _read_number(json_type& value) {
+        T number;
+        if (unlikely(!_read(number))) {
+            return int32_t(error::invalid_binary);
+        }
+        return _number(value, number);
+    }
+
+    /* 按无符号读取再转换为同宽度的有符号数 */
+    template <class Unsigned, class Signed>
+    NODISCARD ALWAYS_INLINE int32_t _read_signed(json_type& value) {
+        Unsigned number;
+        if (unlikely(!_read(number))) {
+            return int32_t(error::invalid_binary);
+        }
+        return _number(value, int64_t(Signed(number)));
+    }
+
+    NODISCARD ALWAYS_INLINE int32_t _string(json_type& value, uint32_t size) {
+        string_view_t text;
+        if (unlikely(!_bytes(text, size))) {
+            return int32_t(error::invalid_binary);
+        }
+        value = json::make_string<json_type>(text, _allocator);
+        return 0;
+    }
+
+    NODISCARD ALWAYS_INLINE int32_t _binary(json_type& value, uint32_t size) {
+        string_view_t bytes;
+        if (unlikely(!_bytes(bytes, size))) {
+            return int32_t(error::invalid_binary);
+        }
+        value = json_type::binary(bytes, _allocator);
+        return 0;
+    }
+
+    NODISCARD int32_t _array(json_type& value, uint32_t size) {
+        /* 每个元素至少 1 字节, 防止恶意的长度提前分配大量内存 */
+        if (unlikely(size > size_t(_end - _cur))) {
+            return int32_t(error::invalid_binary);
+        }
+        value = json_type(array_type(size, _allocator), _allocator);
+        auto& array = value.array();
+        for (uint32_t i = 0u; i < size; ++i) {
+            array.emplace_back(_allocator);
+            int32_t result = _value(array.back());
+            if (unlikely(result != 0)) {
+                return result;
+            }
+        }
+        return 0;
+    }
+
+    NODISCARD int32_t _object(json_type& value, uint32_t size) {
+        if (unlikely(size > size_t(_end - _cur) / 2u)) {
+            return int32_t(error::invalid_binary);
+        }
+        value = json_type(object_type(size, _allocator), _allocator);
+        auto& object = value.object();
+        for (uint32_t i = 0u; i < size; ++i) {
+            if (unlikely(_cur == _end)) {
+                return int32_t(error::invalid_binary);
+            }
+            auto c = *_cur++;
+            uint32_t length{0u};
+            if ((c & 0xE0u) == 0xA0u) {
+                length = c & 0x1Fu;
+            } else if (!((c == 0xD9u && _size<uint8_t>(length)) ||
+                         (c == 0xDAu && _size<uint16_t>(length)) ||
+                         (c == 0xDBu && _size<uint32_t>(length)))) {
+                return int32_t(error::invalid_binary);
+            }
+            string_view_t key;
+            if (unlikely(!_bytes(key, length))) {
+                return int32_t(error::invalid_binary);
+            }
+            object.emplace_back(json::make_key<json_type>(key, _allocator), json_type(_allocator));
+            int32_t result = _value(object.back().value);
+            if (unlikely(result != 0)) {
+                return result;
+            }
+        }
+        return 0;
+    }
+
+    NODISCARD int32_t _value(json_type& value) {
+        if (unlikely(_cur == _end || _depth >= max_depth)) {
+            return int32_t(error::invalid_binary);
+        }
+        auto c = *_cur++;
+        if (c < 0x80u) {
+            return _number(value, uint64_t(c));
+        } else if (c >= 0xE0u) {
+            return _number(value, int64_t(int8_t(c)));
+        } else if (c < 0x90u) {
+            ++_depth;
+            int32_t result = _object(value, c & 0x0Fu);
+            --_depth;
+            return result;
+        } else if (c < 0xA0u) {
+            ++_depth;
+            int32_t result = _array(value, c & 0x0Fu);
+            --_depth;
+            return result;
+        } else if (c < 0xC0u) {
+            return _string(value, c & 0x1Fu);
+        }
+
+        uint32_t size{0u};
+        switch (c) {
+            case 0xC0u: {
+                value = json_type(_allocator);
+                return 0;
+            }
+            case 0xC2u:
+            case 0xC3u: {
+                value = json_type(bool_t(c == 0xC3u), _allocator);
+                return 0;
+            }
+            case 0xC4u:
+                return _size<uint8_t>(size) ? _binary(value, size) : int32_t(error::invalid_binary);
+            case 0xC5u:
+                return _size<uint16_t>(size) ? _binary(value, size) : int32_t(error::invalid_binary);
+            case 0xC6u:
+                return _size<uint32_t>(size) ? _binary(value, size) : int32_t(error::invalid_binary);
+            case 0xCAu: {
+                uint32_t bits;
+                if (unlikely(!_read(bits))) {
+                    return int32_t(error::invalid_binary);
+                }
+                float32_t f;
+                _memcpy_(&f, &bits, sizeof(f));
+                return _number(value, float64_t(f));
+            }
+            case 0xCBu: {
+                uint64_t bits;
+                if (unlikely(!_read(bits))) {
+                    return int32_t(error::invalid_binary);
+                }
+                float64_t f;
+                _memcpy_(&f, &bits, sizeof(f));
+                return _number(value, f);
+            }
+            case 0xCCu:
+                return _read_number<uint8_t>(value);
+            case 0xCDu:
+                return _read_number<uint16_t>(value);
+            case 0xCEu:
+                return _read_number<uint32_t>(value);
+            case 0xCFu:
+                return _read_number<uint64_t>(value);
+            case 0xD0u:
+                return _read_signed<uint8_t, int8_t>(value);
+            case 0xD1u:
+                return _read_signed<uint16_t, int16_t>(value);
+            case 0xD2u:
+                return _read_signed<uint32_t, int32_t>(value);
+            case 0xD3u:
+                return _read_signed<uint64_t, int64_t>(value);
+            case 0xD9u:
+                return _size<uint8_t>(size) ? _string(value, size) : int32_t(error::invalid_binary);
+            case 0xDAu:
+                return _size<uint16_t>(size) ? _string(value, size) : int32_t(error::invalid_binary);
+            case 0xDBu:
+                return _size<uint32_t>(size) ? _string(value, size) : int32_t(error::invalid_binary);
+            case 0xDCu:
+            case 0xDDu:
+            case 0xDEu:
+            case 0xDFu: {
+                bool_t ok = (c & 1u) == 0u ? _size<uint16_t>(size) : _size<uint32_t>(size);
+                if (unlikely(!ok)) {
+                    return int32_t(error::invalid_binary);
+                }
+                ++_depth;
+                int32_t result = c < 0xDEu ? _array(value, size) : _object(value, size);
+                --_depth;
+                return result;
+            }
+            default:
+                /* 0xC1 未使用, 0xC7-0xC9 与 0xD4-0xD8 为 ext */
+                return int32_t(error::invalid_binary);
+        }
+    }
+
+public:
+    ALWAYS_INLINE parser(uint8_t const* begin, uint8_t const* end, allocator_type& allocator) noexcept
+            : _cur(begin), _end(end), _allocator(allocator) {}
+
+    /* 输入必须恰好是一个值 */
+    NODISCARD ALWAYS_INLINE int32_t operator()(json_type* json) {
+        int32_t result = _value(*json);
+        if (result == 0 && _cur != _end) {
+            result = int32_t(error::invalid_binary);
+        }
+        if (result != 0) {
+            *json = json_type(_allocator);
+        }
+        return result;
+    }
+};
+
+template <class Json, class Iter1, class Iter2>
+ALWAYS_INLINE int32_t parse(Json* json, Iter1 begin, Iter2 end) {
+    auto first = (uint8_t const*)(&*begin);
+    return parser<Json>(first, first + (end - begin), json->allocator())(json);
+}
+
+template <class OutStream>
+class encoder final : public object {
+public:
+    using self = encoder;
+    using string_view_t = string::view<char>;
+
+protected:
+    OutStream& _out;
+
+    ALWAYS_INLINE void _write(uint8_t const* data, size_t size) {
+        _out << string_view_t((char const*)(data), (char const*)(data + size));
+    }
+
+    template <class T>
+    ALWAYS_INLINE void _head(uint8_t c, T value) {
+        uint8_t s[1u + sizeof(T)];
+        s[0] = c;
+        memory::store_big_endian(s + 1, value);
+        _write(s, sizeof(s));
+    }
+
+    ALWAYS_INLINE void _byte(uint8_t c) { _write(&c, 1u); }
+
+    /* fix, 8, 16, 32 位长度; fix_limit 为 0 表示没有 fix 格式 */
+    ALWAYS_INLINE void _size(uint8_t fix, uint32_t fix_limit, uint8_t c8, uint8_t c16, uint8_t c32,
+                             size_t size) {
+        if (size < fix_limit) {
+            _byte(uint8_t(fix | size));
+        } else if (c8 != 0u && size <= 0xFFu) {
+            _head(c8, uint8_t(size));
+        } else if (size <= 0xFFFFu) {
+            _head(c16, uint16_t(size));
+        } else {
+            throw_if(size > 0xFFFFFFFFu, "too large");
+            _head(c32, uint32_t(size));
+        }
+    }
+
+    ALWAYS_INLINE void _number(uint64_t value) {
+        if (value < 0x80u) {
+            _byte(uint8_t(value));
+        } else if (value <= 0xFFu) {
+            _head(0xCCu, uint8_t(value));
+        } else if (value <= 0xFFFFu) {
+            _head(0xCDu, uint16_t(value));
+        } else if (value <= 0xFFFFFFFFu) {
+            _head(0xCEu, uint32_t(value));
+        } else {
+            _head(0xCFu, value);
+        }
+    }
+
+    ALWAYS_INLINE void _number(int64_t value) {
+        if (value >= 0) {
+            _number(uint64_t(value));
+        } else if (value >= -32) {
+            _byte(uint8_t(value));
+        } else if (value >= -128) {
+            _head(0xD0u, uint8_t(value));
+        } else if (value >= -32768) {
+            _head(0xD1u, uint16_t(value));
+        } else if (value >= -2147483648ll) {
+            _head(0xD2u, uint32_t(value));
+        } else {
+            _head(0xD3u, uint64_t(value));
+        }
+    }
+
+    ALWAYS_INLINE void _number(float64_t value) {
+        uint64_t bits;
+        _memcpy_(&bits, &value, sizeof(bits));
+        _head(0xCBu, bits);
+    }
+
+    ALWAYS_INLINE void _string(string_view_t text) {
+        json::unescape(text, [this](string_view_t s) {
+            _size(0xA0u, 32u, 0xD9u, 0xDAu, 0xDBu, s.size());
+            _out << s;
+        });
+    }
+
+public:
+    ALWAYS_INLINE explicit encoder(OutStream& out) noexcept : _out(out) {}
+
+    template <class Json>
+    void operator()(Json const& node) {
+        switch (node.type()) {
+            case json::value_enum::null: {
+                _byte(0xC0u);
+                break;
+            }
+            case json::value_enum::boolean: {
+                _byte(node.template get<bool_t>() ? 0xC3u : 0xC2u);
+                break;
+            }
+            case json::value_enum::number:
+            case json::value_enum::number_ref: {
+                node.visit_number([this](auto value) { _number(value); });
+                break;
+            }
+            case json::value_enum::string: {
+                _string(node.template get<string_view_t>());
+                break;
+            }
+            case json::value_enum::binary: {
+                auto bytes = node.binary();
+                _size(0u, 0u, 0xC4u, 0xC5u, 0xC6u, bytes.size());
+                _out << bytes;
+                break;
+            }
+            case json::value_enum::array: {
+                auto& array = node.array();
+                _size(0x90u, 16u, 0u, 0xDCu, 0xDDu, array.size());
+                for (auto& item : array) {
+                    (*this)(item);
+                }
+                break;
+            }
+            case json::value_enum::object: {
+                auto& object = node.object();
+                _size(0x80u, 16u, 0u, 0xDEu, 0xDFu, object.size());
+                for (auto& item : object) {
+                    _string(string_view_t(item.key.begin(), item.key.end()));
+                    (*this)(item.value);
+                }
+                break;
+            }
+        }
+    }
+};
+
+/* 输出端与 json::value::to 相同, 只需支持 << string_view_t */
+template <class Json, class OutStream>
+ALWAYS_INLINE OutStream& to(Json const& json, OutStream& out) {
+    static_assert(sizeof(typename Json::char_type) == 1u, "msgpack only supports 8-bit characters");
+    encoder<OutStream> encoder(out);
+    encoder(json);
+    return out;
+}
+
+};  // namespace msgpack
+
+};  // namespace qlib
+
+#endif
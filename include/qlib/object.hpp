@@ -102,6 +102,19 @@ ALWAYS_INLINE CONSTEXPR void* _memcpy_(void* __dst, void const* __src, size_t __
 #endif
 }
 
+ALWAYS_INLINE CONSTEXPR void* _memset_(void* __dst, int32_t __c, size_t __l) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_memset(__dst, __c, __l);
+#elif defined(_MSC_VER) && (defined(_STRING_H) || defined(_CSTRING_))
+    return memset(__dst, __c, __l);
+#else
+    for (size_t i = 0; i < __l; ++i) {
+        ((uint8_t*)__dst)[i] = uint8_t(__c);
+    }
+    return __dst;
+#endif
+}
+
 ALWAYS_INLINE CONSTEXPR bool_t _isnan_(float64_t __v) noexcept {
 #if defined(__GNUC__) || defined(__clang__)
     return __builtin_isnan(__v);
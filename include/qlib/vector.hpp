@@ -228,6 +228,14 @@ public:
         }
     }
 
+    /* 只析构元素, 保留容量 */
+    ALWAYS_INLINE constexpr void clear() noexcept(is_nothrow_destructible_v<value_type>) {
+        for (size_type i = 0u; i < _size; ++i) {
+            _allocator_().destroy(_impl + i);
+        }
+        _size = 0u;
+    }
+
     ALWAYS_INLINE CONSTEXPR auto& allocator() const noexcept { return _allocator_(); }
 };
 
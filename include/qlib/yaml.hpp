@@ -59,33 +59,10 @@ template <class _Tp>
 class converter<_Tp, enable_if_t<is_floating_point_v<_Tp>>> : public object {
 public:
     template <class Iter1, class Iter2>
-    NODISCARD ALWAYS_INLINE CONSTEXPR static auto decode(Iter1 first, Iter2 last) {
+    NODISCARD ALWAYS_INLINE static auto decode(Iter1 first, Iter2 last) {
         _Tp _value{0u};
-
-        _Tp sign = 1;
-        if (*first == '-') {
-            sign = -1;
-            ++first;
-        }
-
-        while (first < last && is_digit(*first)) {
-            _value = _value * 10u + static_cast<_Tp>(*first - '0');
-            ++first;
-        }
-
-        if (*first == '.') {
-            ++first;
-            _Tp base = 0.1;
-            while (first < last && is_digit(*first)) {
-                _value += static_cast<_Tp>(*first - '0') * base;
-                base *= 0.1;
-                ++first;
-            }
-        }
-
-        throw_if(first != last, "not number");
-
-        return sign * _value;
+        throw_if(string::from_chars(first, last, _value) != last, "not number");
+        return _value;
     }
 };
 
@@ -639,6 +616,13 @@ ALWAYS_INLINE CONSTEXPR auto parse(value<_Char, _Policy, _Allocator>* __yaml,
     return __parser(__yaml, __first, __last);
 }
 
+#if defined(QLIB_FILE_HPP)
+template <class _Char, memory_policy _Policy, class _Allocator>
+ALWAYS_INLINE auto parse(value<_Char, _Policy, _Allocator>* __yaml, mapped_file const& __file) {
+    return parse(__yaml, __file.begin(), __file.end());
+}
+#endif
+
 };  // namespace yaml
 
 namespace string {
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "qlib/cbor.h"
+
+namespace qlib {
+
+static string_t bytes(std::initializer_list<uint8_t> list) {
+    string_t result;
+    for (auto c : list) {
+        result << char(c);
+    }
+    return result;
+}
+
+template <class Json>
+static string_t dump(Json const& json) {
+    string_t result;
+    json.to(result);
+    return result;
+}
+
+TEST(Cbor, RoundTrip) {
+    string_t text(R"({"a":[1,-1,-33,200,-200,70000,-70000,5000000000,-5000000000,)"
+                  R"(18446744073709551615,-9223372036854775808,1.5],"s":"x\"y\né",)"
+                  R"("t":true,"f":false,"n":null,"e":{},"l":[]})");
+    json_t json;
+    EXPECT_EQ(json::parse(&json, text.begin(), text.end()), 0);
+    auto expected = dump(json);
+
+    string_t binary;
+    cbor::to(json, binary);
+    json_t copy;
+    EXPECT_EQ(cbor::parse(&copy, binary.begin(), binary.end()), 0);
+    EXPECT_EQ(dump(copy), expected);
+    EXPECT_EQ(copy["s"].get<string_t>(), "x\"y\n\xc3\xa9");
+
+    json_view_pool_t::allocator_type pool;
+    json_view_pool_t view(pool);
+    EXPECT_EQ(cbor::parse(&view, binary.begin(), binary.end()), 0);
+    EXPECT_EQ(dump(view), expected);
+    auto key = view.object()[0u].key;
+    EXPECT_TRUE(key.data() >= binary.begin() && key.data() < binary.end());
+}
+
+TEST(Cbor, Format) {
+    /* RFC 8949 附录 A 中的例子 */
+    auto check = [](string_t const& input, char const* expected) {
+        json_t json;
+        EXPECT_EQ(cbor::parse(&json, input.begin(), input.end()), 0);
+        EXPECT_EQ(dump(json), expected);
+        json_view_pool_t::allocator_type pool;
+        json_view_pool_t view(pool);
+        EXPECT_EQ(cbor::parse(&view, input.begin(), input.end()), 0);
+        EXPECT_EQ(dump(view), expected);
+    };
+    check(bytes({0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}), "-9223372036854775808");
+    check(bytes({0xF9, 0x3C, 0x00}), "1");
+    check(bytes({0xF9, 0x7B, 0xFF}), "65504");
+    check(bytes({0xF9, 0xC4, 0x00}), "-4");
+    check(bytes({0xF9, 0x7C, 0x00}), "null");
+    check(bytes({0xF7}), "null");
+    check(bytes({0xC1, 0x1A, 0x51, 0x4B, 0x67, 0xB0}), "1363896240");
+    check(bytes({0x7F, 0x65, 's', 't', 'r', 'e', 'a', 0x64, 'm', 'i', 'n', 'g', 0xFF}),
+          R"("streaming")");
+    check(bytes({0x7F, 0x60, 0xFF}), R"("")");
+    check(bytes({0x7F, 0x60, 0x61, 'a', 0x60, 0xFF}), R"("a")");
+    check(bytes({0x7F, 0xFF}), R"("")");
+    check(bytes({0x5F, 0x42, 0x01, 0x02, 0x41, 0x03, 0xFF}), "[1,2,3]");
+    check(bytes({0x9F, 0x01, 0x82, 0x02, 0x03, 0xFF}), "[1,[2,3]]");
+    check(bytes({0xBF, 0x61, 'a', 0x01, 0x61, 'b', 0x9F, 0xFF, 0xFF}), R"({"a":1,"b":[]})");
+
+    auto input = bytes({0xA2, 0x61, 'a', 0x18, 0xC8, 0x61, 'b', 0x82, 0xF5, 0xF6});
+    json_t json;
+    EXPECT_EQ(cbor::parse(&json, input.begin(), input.end()), 0);
+    string_t output;
+    cbor::to(json, output);
+    EXPECT_EQ(output, input);
+
+    for (auto& bad : {bytes({0x19, 0x01}), bytes({0xA1, 0x01, 0x02}), bytes({0xF8, 0x10}),
+                      bytes({0xFF}), bytes({0x9F, 0x01}), bytes({0x7F, 0x41, 'a', 0xFF}),
+                      bytes({0x9B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}),
+                      bytes({0x01, 0x02})}) {
+        EXPECT_EQ(cbor::parse(&json, bad.begin(), bad.end()), int32_t(cbor::error::invalid_binary));
+        EXPECT_TRUE(json.type() == json::value_enum::null);
+    }
+}
+
+};  // namespace qlib
+
+int32_t main(int32_t argc, char* argv[]) {
+    int32_t result{0};
+
+    do {
+        testing::InitGoogleTest(&argc, argv);
+        result = RUN_ALL_TESTS();
+    } while (false);
+
+    return result;
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+
+#include "qlib/file.h"
+#include "qlib/json.h"
+#include "qlib/yaml.h"
+
+namespace qlib {
+
+static string_t write_file(char const* name, string_view_t text) {
+    string_t path("/tmp/");
+    path << string_view_t(name);
+    auto file = fopen(path.c_str(), "wb");
+    EXPECT_NE(file, nullptr);
+    fwrite(text.data(), 1u, text.size(), file);
+    fclose(file);
+    return path;
+}
+
+TEST(File, MappedFileJsonView) {
+    string_view_t text(R"({"name":"qlib","tags":["a","b"],"n":3})");
+    auto path = write_file("qlib_test_file.json", text);
+    mapped_file file(path);
+    EXPECT_TRUE(file.is_open());
+    EXPECT_EQ(file.view(), text);
+
+    /* 末尾的 padding 可读且为 0 */
+    for (size_t i = 0u; i < mapped_file::padding; ++i) {
+        EXPECT_EQ(file.end()[i], '\0');
+    }
+
+    /* view 策略的字符串直接指向映射内存 */
+    json_view_t json;
+    EXPECT_EQ(json::parse(&json, file), 0);
+    auto name = json["name"].get<string_view_t>();
+    EXPECT_EQ(name, "qlib");
+    EXPECT_TRUE(name.data() >= file.begin() && name.data() < file.end());
+    EXPECT_EQ(json["n"].get<int32_t>(), 3);
+
+    json_t copy;
+    EXPECT_EQ(json::parse(&copy, file.begin(), file.end(), json::parse_two_stage), 0);
+    EXPECT_EQ(copy["tags"].array().size(), 2u);
+
+    auto moved = qlib::move(file);
+    EXPECT_FALSE(file.is_open());
+    EXPECT_EQ(moved.size(), text.size());
+    remove(path.c_str());
+}
+
+TEST(File, MappedFileYamlView) {
+    auto path = write_file("qlib_test_file.yaml", "log:\n  level: 2\n  path: auto\n");
+    mapped_file file(path);
+    yaml_view_t root{};
+    EXPECT_EQ(yaml::parse(&root, file), 0);
+    EXPECT_EQ(root["log"]["level"].get<int32_t>(), 2);
+    EXPECT_EQ(root["log"]["path"].get<string_view_t>(), "auto");
+    remove(path.c_str());
+}
+
+TEST(File, MappedFileEdgeCases) {
+    /* 大小恰为整页时 padding 来自额外的匿名页 */
+    string_t text(4096u);
+    text << string_view_t("[0");
+    while (text.size() < 4094u) {
+        text << string_view_t(",0");
+    }
+    text << string_view_t(" ]");
+    auto path = write_file("qlib_test_page.json", text);
+    mapped_file file(path);
+    EXPECT_EQ(file.size(), 4096u);
+    EXPECT_EQ(file.end()[mapped_file::padding - 1u], '\0');
+    json_view_t json;
+    EXPECT_EQ(json::parse(&json, file), 0);
+    remove(path.c_str());
+
+    auto empty = write_file("qlib_test_empty.json", "");
+    EXPECT_EQ(file.open(empty.c_str()), 0);
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(file.begin(), file.end());
+    remove(empty.c_str());
+
+    EXPECT_NE(file.open("/nonexistent/qlib.json"), 0);
+    EXPECT_FALSE(file.is_open());
+    EXPECT_THROW(mapped_file("/nonexistent/qlib.json"), exception);
+}
+
+};  // namespace qlib
+
+int32_t main(int32_t argc, char* argv[]) {
+    int32_t result{0};
+
+    do {
+        testing::InitGoogleTest(&argc, argv);
+        result = RUN_ALL_TESTS();
+    } while (false);
+
+    return result;
+}
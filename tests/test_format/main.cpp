@@ -23,12 +23,20 @@ TEST(format, int) {
 
 TEST(format, float) {
     auto s = fmt::format("{} {}", 1.1f, 2.2f);
-    EXPECT_EQ(s, "1.100000 2.200000");
+    EXPECT_EQ(s, "1.1 2.2");
 }
 
 TEST(format, double) {
     auto s = fmt::format("{} {}", 1.1, 2.2);
-    EXPECT_EQ(s, "1.100000 2.200000");
+    EXPECT_EQ(s, "1.1 2.2");
+}
+
+TEST(format, floatSpecs) {
+    EXPECT_EQ(fmt::format("{} {} {}", 0.1 + 0.2, 1e22, -0.0), "0.30000000000000004 1e+22 -0");
+    EXPECT_EQ(fmt::format("{:e} {:g} {:f}", 1234.5, 1234567.0, 1e-3), "1.2345e+03 1.234567e+06 0.001");
+    EXPECT_EQ(fmt::format("{:.3f} {:.2e} {:.4g} {:.3}", 2.0005, 1234.5, 0.000123456, 1.0 / 3),
+              "2.001 1.23e+03 0.0001235 0.333");
+    EXPECT_EQ(fmt::format("{:.1f} {:.0f}", 0.25, 2.5), "0.2 2");
 }
 
 TEST(format, bool) {
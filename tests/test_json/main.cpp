@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "qlib/json.h"
 #include "qlib/string.h"
 
@@ -413,6 +417,1244 @@ TEST(Json, JsonPoolParse) {
     json_parse(value);
 }
 
+template <class JsonType>
+static void json_two_stage_parse() {
+    using json_type = JsonType;
+    const char* texts[] = {
+        R"({"a":1,"b":[true,false,null],"c":{"d":"e\"f","g":-1.5e3}})",
+        R"([ "\\", "\\\\\"", "{[:,]}", 123 , {} , [] , [[[]]] ])",
+        R"({"padding_padding_padding_padding_padding_padding_padding___":"\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\","x":"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"\"","y":[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30]})",
+    };
+    for (auto text : texts) {
+        json_type expected, value;
+        EXPECT_EQ(json::parse(&expected, text, text + len(text)), 0);
+        EXPECT_EQ(json::parse(&value, text, text + len(text), json::parse_two_stage), 0);
+        EXPECT_EQ(string::from_json(value), string::from_json(expected));
+    }
+
+    const char* invalid[] = {
+        R"({"a" 1})", R"({"a":1 "b":2})", R"([1,2)", R"({"a":"b)", R"([nul])", R"([truex])",
+    };
+    for (auto text : invalid) {
+        json_type value;
+        EXPECT_NE(json::parse(&value, text, text + len(text), json::parse_two_stage), 0);
+    }
+}
+
+TEST(Json, JsonViewTwoStageParse) {
+    json_two_stage_parse<json_view_t>();
+}
+
+TEST(Json, JsonTwoStageParse) {
+    json_two_stage_parse<json_t>();
+}
+
+TEST(Json, DocumentView) {
+    constexpr auto text = R"( {"name": "rules", "skip": {"a": [1, {"b": "}]"}], "c": "\"{"},
+        "rules": [{"name": "light", "pattern": "turn on", "commands": [{"device": "lamp"}]},
+                  {"name": "fan\n", "pattern": "wind", "commands": []}],
+        "count": -12, "ratio": 0.5, "enabled": true, "missing": null} )";
+
+    json::document_view<char> doc(text, text + len(text));
+    EXPECT_EQ(doc.type(), json::value_enum::object);
+    EXPECT_EQ(doc["name"].get<string_view_t>(), "rules");
+    EXPECT_EQ(doc["count"].get<int32_t>(), -12);
+    EXPECT_EQ(doc["ratio"].get<float64_t>(), 0.5);
+    EXPECT_TRUE(doc["enabled"].get<bool_t>());
+    EXPECT_TRUE(doc["missing"].empty());
+    EXPECT_TRUE(doc["absent"].empty());
+    EXPECT_EQ(doc["skip"]["c"].get<string_view_t>(), "\\\"{");
+
+    auto rules = doc["rules"];
+    EXPECT_EQ(rules.size(), 2u);
+    EXPECT_EQ(rules.at(0)["commands"].at(0)["device"].get<string_view_t>(), "lamp");
+    EXPECT_EQ(rules.at(1)["name"].get<string_t>(), "fan\n");
+    EXPECT_EQ(rules.at(1)["commands"].size(), 0u);
+
+    size_t keys{0u};
+    for (auto& member : doc) {
+        EXPECT_FALSE(member.key.empty());
+        ++keys;
+    }
+    EXPECT_EQ(keys, 7u);
+
+    json_view_t value;
+    EXPECT_EQ(rules.at(0).parse(&value), 0);
+    EXPECT_EQ(value, R"({"name":"light","pattern":"turn on","commands":[{"device":"lamp"}]})");
+    EXPECT_EQ(doc["count"].parse(&value), 0);
+    EXPECT_EQ(value.get<int32_t>(), -12);
+}
+
+TEST(Json, JsonPointer) {
+    string_t text(R"({"configurePresets":[{"name":"windows","cacheVariables":{"CMAKE_BUILD_TYPE":)"
+                  R"({"type":"STRING","value":"Release"}}},{"name":"linux","skip":{"x":[1,"]"]}}],)"
+                  R"("a/b":1,"m~n":2,"q\"k":3,"":4,"arr":[10,20,30]})");
+    json_t json;
+    EXPECT_EQ(json::parse(&json, text.begin(), text.end()), 0);
+    auto const& value = json;
+
+    json::pointer<> build_type("/configurePresets/0/cacheVariables/CMAKE_BUILD_TYPE/value");
+    EXPECT_EQ(build_type.size(), 5u);
+    EXPECT_EQ(build_type[2u], "cacheVariables");
+    EXPECT_EQ(build_type.resolve(value)->get<string_t>(), "Release");
+    EXPECT_EQ(build_type.resolve(text.begin(), text.end()).get<string_view_t>(), "Release");
+
+    /* "~1" 与 "~0" 转义, 键按转义后的原文比较 */
+    EXPECT_EQ(json::pointer<>("").resolve(value), &value);
+    EXPECT_EQ(json::pointer<>("/").resolve(value)->get<int32_t>(), 4);
+    EXPECT_EQ(json::pointer<>("/a~1b").resolve(value)->get<int32_t>(), 1);
+    EXPECT_EQ(json::pointer<>("/m~0n").resolve(text.begin(), text.end()).get<int32_t>(), 2);
+    EXPECT_EQ(json::pointer<>("/q\"k").resolve(value)->get<int32_t>(), 3);
+    EXPECT_EQ(json::pointer<>("/q\"k").resolve(text.begin(), text.end()).get<int32_t>(), 3);
+    EXPECT_EQ(json::pointer<>("/arr/2").resolve(text.begin(), text.end()).get<int32_t>(), 30);
+    for (auto path : {"/arr/3", "/arr/01", "/arr/-", "/none", "/a~1b/c", "/configurePresets/x"}) {
+        json::pointer<> pointer(path);
+        EXPECT_EQ(pointer.resolve(value), nullptr) << path;
+        EXPECT_TRUE(pointer.resolve(text.begin(), text.end()).empty()) << path;
+    }
+    EXPECT_ANY_THROW(json::pointer<>("a"));
+    EXPECT_ANY_THROW(json::pointer<>("/~2"));
+
+    /* 大对象使用解析时建立的哈希索引 */
+    string_t large("{");
+    for (int32_t i = 0; i < 100; ++i) {
+        large << (i ? "," : "") << "\"key" << string_t::from(i) << "\":" << string_t::from(i);
+    }
+    large << "}";
+    json_t indexed;
+    EXPECT_EQ(json::parse(&indexed, large.begin(), large.end(), json::parse_hash_index), 0);
+    EXPECT_EQ(json::pointer<>("/key57").resolve(indexed)->get<int32_t>(), 57);
+    EXPECT_EQ(json::pointer<>("/key100").resolve(indexed), nullptr);
+
+    /* 一次扫描求出多个路径, 重复的路径与前缀都可以 */
+    json::pointer_set<> set;
+    EXPECT_EQ(set.add("/arr/1"), 0u);
+    EXPECT_EQ(set.add("/configurePresets/0/cacheVariables/CMAKE_BUILD_TYPE/type"), 1u);
+    EXPECT_EQ(set.add("/configurePresets/0/name"), 2u);
+    EXPECT_EQ(set.add("/none"), 3u);
+    EXPECT_EQ(set.add("/arr/1"), 4u);
+    EXPECT_EQ(set.add("/configurePresets/1"), 5u);
+    EXPECT_EQ(set.add(""), 6u);
+    vector_t<json::document_view<char>> results;
+    set.extract(text.begin(), text.end(), results);
+    EXPECT_EQ(results.size(), 7u);
+    EXPECT_EQ(results[0u].get<int32_t>(), 20);
+    EXPECT_EQ(results[1u].get<string_view_t>(), "STRING");
+    EXPECT_EQ(results[2u].get<string_view_t>(), "windows");
+    EXPECT_TRUE(results[3u].empty());
+    EXPECT_EQ(results[4u].get<int32_t>(), 20);
+    EXPECT_EQ(results[5u]["name"].get<string_view_t>(), "linux");
+    EXPECT_EQ(results[6u].raw().size(), text.size());
+
+    /* 重复的键只取第一次出现的值, 不影响其它路径 */
+    string_t dup(R"({"a":1,"a":2,"b":3})");
+    json::pointer_set<> pair;
+    pair.add("/a");
+    pair.add("/b");
+    pair.extract(dup.begin(), dup.end(), results);
+    EXPECT_EQ(results[0u].get<int32_t>(), 1);
+    EXPECT_EQ(results[1u].get<int32_t>(), 3);
+}
+
+template <class JsonType>
+static void json_hash_index() {
+    using json_type = JsonType;
+    string_t text("{");
+    for (int32_t i = 0; i < 100; ++i) {
+        text << (i == 0 ? "\"key" : ",\"key") << string_t::from(i) << "\":" << string_t::from(i);
+    }
+    text << "}";
+
+    json_type value;
+    EXPECT_EQ(json::parse(&value, text.begin(), text.end(), json::parse_hash_index), 0);
+    auto const& const_value = value;
+    for (int32_t i = 0; i < 100; ++i) {
+        auto key = string_t("key") << string_t::from(i);
+        EXPECT_EQ(const_value[key].template get<int32_t>(), i);
+        EXPECT_NE(const_value.find(key), const_value.object().end());
+    }
+    EXPECT_TRUE(const_value["key100"].empty());
+    EXPECT_EQ(value.find("key100"), value.object().end());
+
+    value["key100"] = 100;
+    value["key101"] = 101;
+    EXPECT_EQ(value.object().size(), 102u);
+    EXPECT_EQ(value["key100"].template get<int32_t>(), 100);
+    EXPECT_EQ(const_value["key101"].template get<int32_t>(), 101);
+    EXPECT_EQ(value.find("key0") - value.object().begin(), 0);
+
+    /* 经 object() 修改后已有的索引失效, 大小不变也不会查错 */
+    auto& members = value.object();
+    members.pop_back();
+    members.emplace_back("new", 7);
+    EXPECT_EQ(const_value["new"].template get<int32_t>(), 7);
+    EXPECT_EQ(value.find("new")->value.template get<int32_t>(), 7);
+    EXPECT_EQ(value.find("key101"), value.object().end());
+    value["new"] = 8;
+    EXPECT_EQ(value.object().size(), 102u);
+    EXPECT_EQ(const_value["new"].template get<int32_t>(), 8);
+
+    json_type copy = value;
+    EXPECT_EQ(copy["key57"].template get<int32_t>(), 57);
+
+    /* 未带 parse_hash_index 时, 第一次非 const 查找才建立索引 */
+    json_type lazy;
+    EXPECT_EQ(json::parse(&lazy, text.begin(), text.end()), 0);
+    EXPECT_EQ(lazy.find("key42")->value.template get<int32_t>(), 42);
+    json_type moved = std::move(lazy);
+    EXPECT_EQ(moved.object().size(), 100u);
+    EXPECT_EQ(moved["key99"].template get<int32_t>(), 99);
+    EXPECT_EQ(json_type(moved)["key98"].template get<int32_t>(), 98);
+}
+
+TEST(Json, JsonHashIndex) {
+    json_hash_index<json_t>();
+}
+
+TEST(Json, JsonViewHashIndex) {
+    json_hash_index<json_view_t>();
+}
+
+/* 索引与数值缓存放在结点之外或头部的空隙中, 结点保持 24 字节 */
+TEST(Json, JsonNodeSize) {
+    EXPECT_EQ(sizeof(json_t), 24u);
+    EXPECT_EQ(sizeof(json_view_t), 24u);
+}
+
+template <class JsonType>
+static void json_number_cache() {
+    using json_type = JsonType;
+    string_t text(R"({"u":18446744073709551615,"i":-9223372036854775808,"f":1.50,"e":1e3,"s":-0})");
+
+    json_type value;
+    EXPECT_EQ(json::parse(&value, text.begin(), text.end(), json::parse_number_cache), 0);
+    auto const& const_value = value;
+    EXPECT_EQ(const_value["u"].template get<qlib::uint64_t>(), 18446744073709551615ull);
+    EXPECT_EQ(const_value["i"].template get<qlib::int64_t>(), -9223372036854775807ll - 1);
+    EXPECT_EQ(const_value["f"].template get<float64_t>(), 1.5);
+    EXPECT_EQ(const_value["f"].template get<float32_t>(), 1.5f);
+    EXPECT_EQ(const_value["e"].template get<int32_t>(), 1000);
+    EXPECT_EQ(const_value["e"].template get<float64_t>(), 1e3);
+    EXPECT_EQ(const_value["s"].template get<int32_t>(), 0);
+    EXPECT_ANY_THROW((void)const_value["i"].template get<uint32_t>());
+    EXPECT_EQ(const_value.to(), text);
+
+    /* 未开启时在非 const 首次读取时缓存 */
+    json_type lazy;
+    EXPECT_EQ(json::parse(&lazy, text.begin(), text.end()), 0);
+    EXPECT_EQ(lazy["f"].template get<float64_t>(), 1.5);
+    auto const copy = lazy;
+    EXPECT_EQ(copy["f"].template get<float64_t>(), 1.5);
+    EXPECT_EQ(copy["u"].template get<float64_t>(), 18446744073709551615.0);
+    EXPECT_EQ(copy.to(), text);
+
+    lazy["d"] = 0.1;
+    EXPECT_EQ(lazy["d"].template get<float64_t>(), 0.1);
+    EXPECT_EQ(lazy["d"].to(), "0.1");
+}
+
+TEST(Json, JsonNumberCache) {
+    json_number_cache<json_t>();
+}
+
+TEST(Json, JsonViewNumberCache) {
+    json_number_cache<json_view_t>();
+}
+
+template <class JsonType>
+static bool_t json_exact_capacity_check(JsonType const& node) {
+    if (node.type() == json::value_enum::object) {
+        if (node.object().capacity() != node.object().size()) {
+            return False;
+        }
+        for (auto& item : node.object()) {
+            if (!json_exact_capacity_check(item.value)) {
+                return False;
+            }
+        }
+    } else if (node.type() == json::value_enum::array) {
+        if (node.array().capacity() != node.array().size()) {
+            return False;
+        }
+        for (auto& item : node.array()) {
+            if (!json_exact_capacity_check(item)) {
+                return False;
+            }
+        }
+    }
+    return True;
+}
+
+template <class JsonType>
+static void json_exact_capacity() {
+    using json_type = JsonType;
+    string_t text(R"({"a":[1,[2,3],{"b":"x,y]"},[],{}],"c":{"d":[true,false,null]},"e":"}"})");
+
+    json_type value;
+    EXPECT_EQ(json::parse(&value, text.begin(), text.end(), json::parse_exact_capacity), 0);
+    EXPECT_TRUE(json_exact_capacity_check(value));
+    EXPECT_EQ(value.to(), text);
+    EXPECT_EQ(value["a"].array().size(), 5u);
+
+    /* 预扫描只给出容量, 非法输入仍由建树阶段报错 */
+    string_t invalid(R"({"a":[1,2}})");
+    EXPECT_NE(json::parse(&value, invalid.begin(), invalid.end(), json::parse_exact_capacity), 0);
+}
+
+TEST(Json, JsonExactCapacity) {
+    json_exact_capacity<json_t>();
+}
+
+TEST(Json, JsonViewExactCapacity) {
+    json_exact_capacity<json_view_t>();
+}
+
+TEST(Json, JsonUnescape) {
+    /* 跨越 SIMD 块边界的转义序列 */
+    for (size_t pad = 0u; pad < 40u; ++pad) {
+        string_t text(R"({"s":")");
+        string_t expected(64u);
+        for (size_t i = 0u; i < pad; ++i) {
+            text << 'a';
+            expected << 'a';
+        }
+        text << string_view_t(R"(\"\\\/\b\f\n\r\té€😀 中文 end"})");
+        expected << string_view_t("\"\\/\b\f\n\r\t\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80 中文 end");
+        json_view_t value;
+        EXPECT_EQ(json::parse(&value, text.begin(), text.end(), json::parse_validate_utf8), 0);
+        EXPECT_EQ(value["s"].get<string_t>(), expected);
+    }
+}
+
+TEST(Json, JsonValidateUtf8) {
+    string_t valid("[\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\"]");
+    string_t invalid[] = {
+        string_t("[\"\xc3\"]"),
+        string_t("[\"\xc0\xaf\"]"),
+        string_t("[\"\xed\xa0\x80\"]"),
+        string_t("[\"\xf4\x90\x80\x80\"]"),
+        string_t("[\"\xe2\x82\"]"),
+    };
+    json_t value;
+    EXPECT_EQ(json::parse(&value, valid.begin(), valid.end(), json::parse_validate_utf8), 0);
+    for (auto& text : invalid) {
+        EXPECT_EQ(json::parse(&value, text.begin(), text.end(), json::parse_validate_utf8),
+                  int32_t(json::error::invalid_utf8));
+        EXPECT_EQ(json::parse(&value, text.begin(), text.end()), 0);
+    }
+
+    /* 长输入走向量路径, 末尾截断的多字节序列也要报错 */
+    string_t text(256u);
+    text << string_view_t("[\"");
+    for (size_t i = 0u; i < 40u; ++i) {
+        text << string_view_t("ab\xc3\xa9");
+    }
+    text << string_view_t("\"]");
+    EXPECT_EQ(json::parse(&value, text.begin(), text.end(), json::parse_validate_utf8), 0);
+    EXPECT_TRUE(json::simd::validate_utf8((uint8_t const*)(text.data()),
+                                          (uint8_t const*)(text.data()) + text.size()));
+    EXPECT_FALSE(json::simd::validate_utf8((uint8_t const*)(text.data()),
+                                           (uint8_t const*)(text.data()) + text.size() - 3u));
+}
+
+struct json_binding_command {
+    string_view_t device;
+    string_t action;
+};
+
+struct json_binding_rule {
+    string_t name;
+    qlib::int32_t priority{0};
+    float64_t weight{0.0};
+    bool_t enabled{False};
+    vector_t<qlib::uint32_t> ids;
+    vector_t<json_binding_command> commands;
+};
+
+namespace qlib {
+namespace json {
+template <>
+struct binding<json_binding_command> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("device", value.device);
+        func("action", value.action);
+    }
+};
+
+template <>
+struct binding<json_binding_rule> {
+    template <class T, class Func>
+    static void visit(T& value, Func&& func) {
+        func("name", value.name);
+        func("priority", value.priority);
+        func("weight", value.weight);
+        func("enabled", value.enabled);
+        func("ids", value.ids);
+        func("commands", value.commands);
+    }
+};
+};  // namespace json
+};  // namespace qlib
+
+TEST(Json, JsonBinding) {
+    EXPECT_TRUE(json::is_bound_v<json_binding_rule>);
+    EXPECT_FALSE(json::is_bound_v<json_t>);
+
+    /* 键的顺序任意, 未知的键跳过 */
+    string_t text(R"({
+        "commands": [{"action": "on\nline", "device": "la\"mp", "extra": [1, {"a": 2}]}],
+        "unknown": {"x": [true, null], "s": "}]\\\"{[ 0123456789abcdef0123456789abcdef"},
+        "name": "régle", "priority": -3, "weight": 2.5e1, "enabled": true, "ids": [1, 2, 3]
+    })");
+    json_binding_rule rule;
+    EXPECT_EQ(json::decode(&rule, text.begin(), text.end()), 0);
+    EXPECT_EQ(rule.name, string_t("r\xc3\xa9gle"));
+    EXPECT_EQ(rule.priority, -3);
+    EXPECT_EQ(rule.weight, 25.0);
+    EXPECT_TRUE(rule.enabled);
+    EXPECT_EQ(rule.ids.size(), 3u);
+    EXPECT_EQ(rule.ids[2], 3u);
+    EXPECT_EQ(rule.commands.size(), 1u);
+    EXPECT_EQ(rule.commands[0].device, string_view_t(R"(la\"mp)"));
+    EXPECT_EQ(rule.commands[0].action, string_t("on\nline"));
+
+    /* 与 json_view_t 解析同一文本的结果一致 */
+    json_view_t view;
+    EXPECT_EQ(json::parse(&view, text.begin(), text.end()), 0);
+    EXPECT_EQ(rule.name, view["name"].get<string_t>());
+    EXPECT_EQ(rule.commands[0].device, view["commands"].array()[0u]["device"].get<string_view_t>());
+
+    /* 同一份绑定用于序列化, 输出可以重新解码 */
+    string_t out;
+    auto sink = json::make_sink([&out](char const* data, size_t size) {
+        out << string_view_t(data, data + size);
+    });
+    {
+        json::writer<decltype(sink)> writer(sink);
+        json::encode(writer, rule);
+    }
+    EXPECT_EQ(out, string_t(R"({"name":"r)"
+                            "\xc3\xa9"
+                            R"(gle","priority":-3,"weight":25,"enabled":true,"ids":[1,2,3],)"
+                            R"("commands":[{"device":"la\"mp","action":"on\nline"}]})"));
+    json_binding_rule copy;
+    EXPECT_EQ(json::decode(&copy, out.begin(), out.end()), 0);
+    EXPECT_EQ(copy.commands[0].action, rule.commands[0].action);
+    EXPECT_EQ(copy.ids.size(), 3u);
+
+    /* 缺失的键保持原值, 错误返回错误码 */
+    string_t partial(R"({"priority":7})");
+    EXPECT_EQ(json::decode(&copy, partial.begin(), partial.end()), 0);
+    EXPECT_EQ(copy.priority, 7);
+    EXPECT_EQ(copy.name, rule.name);
+    string_t invalid(R"({"enabled":tru})");
+    EXPECT_EQ(json::decode(&copy, invalid.begin(), invalid.end()),
+              int32_t(json::error::invalid_boolean));
+    string_t unclosed(R"({"ids":[1,2})");
+    EXPECT_NE(json::decode(&copy, unclosed.begin(), unclosed.end()), 0);
+    string_t trailing(R"({} x)");
+    EXPECT_NE(json::decode(&copy, trailing.begin(), trailing.end()), 0);
+}
+
+template <class JsonType>
+static void json_equal() {
+    using json_type = JsonType;
+    string_t text(R"({"a":[1,2.5,"x\"y",true,null],"b":{"c":{},"d":-3},"u":18446744073709551615})");
+    string_t other(R"({"u":18446744073709551615,"b":{"d":-3.0,"c":{}},"a":[1.0,25e-1,"x\u0022y",true,null]})");
+
+    json_type value, same;
+    EXPECT_EQ(json::parse(&value, text.begin(), text.end()), 0);
+    EXPECT_EQ(json::parse(&same, other.begin(), other.end()), 0);
+
+    /* 键的顺序, 数值的写法与字符串的转义都不影响结果 */
+    EXPECT_TRUE(value == same);
+    EXPECT_TRUE(value == other);
+    EXPECT_TRUE(value == " { \"b\" : { \"c\" : { } , \"d\" : -3 } , \"a\" : [ 1 , 2.5 , \"x\\\"y\" , "
+                         "true , null ] , \"u\" : 18446744073709551615 } ");
+    json_t copy;
+    EXPECT_EQ(json::parse(&copy, text.begin(), text.end()), 0);
+    EXPECT_TRUE(value == copy);
+
+    EXPECT_TRUE(value != R"({"a":[1,2.5,"x\"y",true,null],"b":{"c":{},"d":-3}})");
+    EXPECT_TRUE(value != R"({"a":[1,2.5,"x\"y",true],"b":{"c":{},"d":-3},"u":18446744073709551615})");
+    EXPECT_TRUE(value != R"({"a":[1,2.5,"x\"y",true,null],"b":{"c":{},"d":-3},"u":1.8446744073709552e19})");
+    EXPECT_TRUE(value != R"({"a":[1,2.5,"xy",true,null],"b":{"c":{},"d":-3},"u":18446744073709551615})");
+    EXPECT_TRUE(value != R"({"a":[1,2.5,"x\"y",true,null],"b":{"c":{},"d":-3},"u":18446744073709551615)");
+    EXPECT_TRUE(value != R"({"a":[1,2.5,"x\"y",true,null],"b":{"c":{},"d":-3},"u":18446744073709551615}])");
+    same["b"]["d"] = -4;
+    EXPECT_TRUE(value != same);
+
+    /* 大对象按哈希查找 */
+    string_t forward("{"), backward("{");
+    for (int32_t i = 0; i < 64; ++i) {
+        auto key = string_t::from(i);
+        auto back = string_t::from(63 - i);
+        forward << (i == 0 ? "" : ",") << "\"k" << key << "\":" << key;
+        backward << (i == 0 ? "" : ",") << "\"k" << back << "\":" << back;
+    }
+    forward << "}";
+    backward << "}";
+    json_type a, b;
+    EXPECT_EQ(json::parse(&a, forward.begin(), forward.end()), 0);
+    EXPECT_EQ(json::parse(&b, backward.begin(), backward.end()), 0);
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a == backward);
+    b["k7"] = 8;
+    EXPECT_TRUE(a != b);
+
+    /* 重复的键不能匹配到同一个成员, 比较结果与方向无关 */
+    string_t dup(R"({"a":1,"a":1})"), distinct(R"({"a":1,"b":2})");
+    json_type c, d;
+    EXPECT_EQ(json::parse(&c, dup.begin(), dup.end()), 0);
+    EXPECT_EQ(json::parse(&d, distinct.begin(), distinct.end()), 0);
+    EXPECT_TRUE(c != d);
+    EXPECT_TRUE(d != c);
+    EXPECT_TRUE(c != distinct);
+    EXPECT_TRUE(d != dup);
+    EXPECT_TRUE(c == dup);
+    EXPECT_TRUE(c == c);
+}
+
+TEST(Json, JsonEqual) {
+    json_equal<json_t>();
+}
+
+TEST(Json, JsonViewEqual) {
+    json_equal<json_view_t>();
+}
+
+template <class JsonType>
+static void json_writer() {
+    using json_type = JsonType;
+    string_t text(R"({"a":[1,2.5,"x\"y",true,null,{}],"b":{"c":[]},"d":-3})");
+
+    json_type value;
+    EXPECT_EQ(json::parse(&value, text.begin(), text.end()), 0);
+
+    string_t out;
+    auto sink = json::make_sink([&out](char const* data, size_t size) {
+        out << string_view_t(data, data + size);
+    });
+    {
+        json::writer<decltype(sink)> writer(sink, 0u, 7u);
+        writer.write(value);
+    }
+    EXPECT_EQ(out, text);
+
+    /* 顶层的多个值按行分隔 */
+    out.clear();
+    {
+        json::writer<decltype(sink)> writer(sink);
+        writer.write(value["b"]).null();
+    }
+    EXPECT_EQ(out, "{\"c\":[]}\nnull");
+
+    out.clear();
+    {
+        json::writer<decltype(sink)> writer(sink, 2u, 16u);
+        writer.write(value);
+    }
+    EXPECT_EQ(out, "{\n  \"a\": [\n    1,\n    2.5,\n    \"x\\\"y\",\n    true,\n    null,\n    {}\n  ],"
+                   "\n  \"b\": {\n    \"c\": []\n  },\n  \"d\": -3\n}");
+
+    /* 超过 SIMD 块长度的字符串, 转义字符位于块内不同位置 */
+    string_t long_str(100u);
+    for (int32_t i = 0; i < 100; ++i) {
+        long_str << (i == 40 ? "\x01" : i == 70 ? "\n" : i == 99 ? "\\" : "a");
+    }
+    out.clear();
+    {
+        json::writer<decltype(sink)> writer(sink, 0u, 8u);
+        writer.begin_array()
+            .str("a\"b\\c\td")
+            .number(-42)
+            .number(0.1)
+            .boolean(False)
+            .null()
+            .begin_object()
+            .key("k\n")
+            .str(long_str)
+            .key("v")
+            .write(value["b"])
+            .end_object()
+            .end_array();
+    }
+    string_t expected(R"(["a\"b\\c\td",-42,0.1,false,null,{"k\n":")");
+    for (int32_t i = 0; i < 99; ++i) {
+        expected << (i == 40 ? "\\u0001" : i == 70 ? "\\n" : "a");
+    }
+    expected << R"(\\","v":{"c":[]}}])";
+    EXPECT_EQ(out, expected);
+
+    json_type result;
+    EXPECT_EQ(json::parse(&result, out.begin(), out.end()), 0);
+    EXPECT_EQ(result.array().size(), 6u);
+}
+
+TEST(Json, JsonWriter) {
+    json_writer<json_t>();
+}
+
+TEST(Json, JsonViewWriter) {
+    json_writer<json_view_t>();
+}
+
+template <class JsonType>
+static void json_lines_reader() {
+    using json_type = JsonType;
+    using document = typename json::lines_reader<json_type>::document;
+    string_t text;
+    for (int32_t i = 0; i < 1000; ++i) {
+        if (i == 500) {
+            text << "x\n\r\n";
+        }
+        text << "{\"id\":" << string_t::from(i) << "}" << (i % 3 == 0 ? "\r\n" : "\n");
+    }
+
+    for (uint32_t threads : {1u, 4u}) {
+        for (bool_t ordered : {True, False}) {
+            json::lines_reader<json_type> reader(text.begin(), text.end(), json::parse_default, 256u);
+            EXPECT_GT(reader.chunks(), 1u);
+            qlib::int64_t sum{0};
+            size_t count{0u}, errors{0u}, last{0u};
+            bool_t in_order{True};
+            reader.for_each(
+                [&](document& doc) {
+                    in_order = in_order && doc.line > last;
+                    last = doc.line;
+                    if (doc.result != 0) {
+                        EXPECT_EQ(doc.line, 501u);
+                        EXPECT_EQ(doc.text, "x");
+                        ++errors;
+                        return;
+                    }
+                    auto id = doc.value["id"].template get<int32_t>();
+                    EXPECT_EQ(doc.line, size_t(id) + (id < 500 ? 1u : 3u));
+                    sum += id;
+                    ++count;
+                },
+                threads, ordered);
+            EXPECT_EQ(count, 1000u);
+            EXPECT_EQ(errors, 1u);
+            EXPECT_EQ(sum, 499500);
+            if (ordered) {
+                EXPECT_TRUE(in_order);
+            }
+
+            /* 回调抛出的异常传给调用方, 未交付的块全部释放 */
+            size_t seen{0u};
+            EXPECT_ANY_THROW(reader.for_each(
+                [&](document& doc) {
+                    throw_if(doc.line == 300u, "stop");
+                    ++seen;
+                },
+                threads, ordered));
+            EXPECT_LT(seen, 1001u);
+        }
+    }
+}
+
+TEST(Json, JsonLinesReader) {
+    json_lines_reader<json_t>();
+}
+
+TEST(Json, JsonViewPoolLinesReader) {
+    json_lines_reader<json_view_pool_t>();
+}
+
+TEST(Json, JsonIntern) {
+    json_intern_t table;
+    string_t a(R"({"id":1,"user":{"id":2,"name":"x"},"text":"a"})");
+    string_t b(R"([{"text":"b","id":3}])");
+    json_view_pool_t::allocator_type pool;
+    json_view_pool_t x(pool), y(pool);
+    EXPECT_EQ(json::parse(&x, a.begin(), a.end(), json::parse_default, table), 0);
+    EXPECT_EQ(json::parse(&y, b.begin(), b.end(), json::parse_two_stage, table), 0);
+    EXPECT_EQ(table.size(), 4u);
+
+    /* 相同的键在所有文档中地址相同, 且不再指向输入 */
+    auto& id = table.intern("id");
+    EXPECT_EQ(id.id, 0u);
+    EXPECT_EQ(x.object()[0u].key.data(), id.text.data());
+    EXPECT_EQ(x["user"].object()[0u].key.data(), id.text.data());
+    EXPECT_EQ(y.array()[0u].object()[1u].key.data(), id.text.data());
+    EXPECT_TRUE(id.text.data() < a.begin() || id.text.data() >= a.end());
+    EXPECT_EQ(x[id.text].get<int32_t>(), 1);
+    EXPECT_EQ(table.find("text")->id, 3u);
+    EXPECT_TRUE(table.find("missing") == nullptr);
+    EXPECT_EQ(table.size(), 4u);
+
+    /* 扩容与多线程共享 */
+    json_intern_t shared(4u);
+    vector_t<std::thread> threads(4u);
+    vector_t<json_intern_t::entry const*> entries(4u * 256u);
+    entries.resize(4u * 256u);
+    for (uint32_t t = 0u; t < 4u; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0u; i < 256u; ++i) {
+                auto key = string_t::from((i * 7u + t) % 256u);
+                entries[t * 256u + i] = &shared.intern(key);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(shared.size(), 256u);
+    for (uint32_t i = 0u; i < 4u * 256u; ++i) {
+        auto entry = entries[i];
+        EXPECT_EQ(entry, shared.find(entry->text));
+        EXPECT_LT(entry->id, 256u);
+    }
+
+    /* 按行解析时各块共用驻留表 */
+    string_t lines;
+    for (int32_t i = 0; i < 100; ++i) {
+        lines << "{\"id\":" << string_t::from(i) << "}\n";
+    }
+    json::lines_reader<json_view_pool_t> reader(lines.begin(), lines.end(), json::parse_default,
+                                                64u);
+    reader.intern(table);
+    size_t count{0u};
+    reader.for_each(
+        [&](json::lines_reader<json_view_pool_t>::document& doc) {
+            count += doc.value.object()[0u].key.data() == id.text.data();
+        },
+        4u);
+    EXPECT_EQ(count, 100u);
+}
+
+TEST(Json, JsonParseContext) {
+    json::parse_context<json_view_pool_t> context(json::parse_default, 256u);
+    string_t small(R"({"a":[1,2,3],"b":"xA"})");
+    EXPECT_EQ(context.parse(small.begin(), small.end()), 0);
+    EXPECT_EQ(context.document()["a"].array().size(), 3u);
+    string_t out;
+    EXPECT_EQ(context.document().to(out), small);
+    auto first = context.stats();
+    EXPECT_EQ(first.documents, 1u);
+    EXPECT_GT(first.bytes, 0u);
+
+    /* 文档超出初始容量时分配器扩展, 回收后合并为一块, 同样大小的文档不再分配 */
+    string_t large("[");
+    for (int32_t i = 0; i < 1000; ++i) {
+        large << (i ? "," : "") << R"({"id":)" << string_t::from(i) << "}";
+    }
+    large << "]";
+    for (int32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(context.parse(large.begin(), large.end()), 0);
+        EXPECT_EQ(context.document().array().size(), 1000u);
+        EXPECT_EQ(context.document().array()[999u]["id"].get<int32_t>(), 999);
+    }
+    auto& stats = context.stats();
+    EXPECT_EQ(stats.documents, 4u);
+    EXPECT_GT(stats.peak_bytes, first.bytes);
+    EXPECT_GE(stats.capacity, stats.peak_bytes);
+    auto capacity = stats.capacity;
+    EXPECT_EQ(context.parse(large.begin(), large.end()), 0);
+    EXPECT_EQ(context.allocator().capacity(), capacity);
+
+    string_t invalid(R"({"a":tru})");
+    EXPECT_NE(context.parse(invalid.begin(), invalid.end()), 0);
+    EXPECT_EQ(context.parse(small.begin(), small.end()), 0);
+    EXPECT_EQ(context.document()["b"].get<string_view_t>(), "xA");
+
+    json::parse_context<json_pool_t> exact(json::parse_exact_capacity);
+    EXPECT_EQ(exact.parse(large.begin(), large.end()), 0);
+    EXPECT_EQ(exact.document().array().size(), 1000u);
+    EXPECT_GT(exact.stats().peak_structurals, 0u);
+}
+
+TEST(Json, JsonValidate) {
+    /* 与两阶段解析的错误码一致, 不建树 */
+    for (auto text : {"{}", "[]", R"({"a":[1,-2.5e3,true,false,null,"x\"y"],"b":{}})", "[1,2] ",
+                      "", "1", R"({"a" 1})", R"({"a":})", "[1,]", R"({"a":1,})", "[nul]",
+                      "[tru]", "[falsey]", "[x]", "[1 2]", R"([1"a"])", "[", R"({"a")",
+                      R"(["abc)", "[}", "{]", "{1:2}", "[,1]", R"({"a":1] )"}) {
+        string_t input(text);
+        json_view_pool_t::allocator_type pool;
+        json_view_pool_t json(pool);
+        EXPECT_EQ(json::validate(input.begin(), input.end()),
+                  json::parse(&json, input.begin(), input.end(), json::parse_two_stage))
+            << text;
+    }
+
+    size_t offset{0u};
+    string_t missing_colon(R"({"key" 1})");
+    EXPECT_EQ(json::validate(missing_colon.begin(), missing_colon.end(), &offset),
+              int32_t(json::error::missing_colon));
+    EXPECT_EQ(offset, 7u);
+
+    /* 跨 64 字节块的数字 */
+    string_t numbers("[");
+    for (int32_t i = 0; i < 64; ++i) {
+        numbers << (i ? "," : "") << "-123456.789e-10";
+    }
+    numbers << "]";
+    EXPECT_EQ(json::validate(numbers.begin(), numbers.end()), 0);
+    numbers[numbers.size() - 3u] = 'x';
+    EXPECT_EQ(json::validate(numbers.begin(), numbers.end(), &offset),
+              int32_t(json::error::invalid_number));
+    EXPECT_EQ(offset, numbers.size() - 16u);
+
+    /* 比解析更严格: 根结点之后的字符, RFC 8259 的数字语法, 字符串中的控制字符 */
+    struct {
+        char const* text;
+        json::error error;
+        size_t offset;
+    } strict[] = {
+        {"{} x", json::error::trailing_characters, 3u},
+        {"{}]", json::error::trailing_characters, 2u},
+        {"{}{}", json::error::trailing_characters, 2u},
+        {"[] \n\t\"a", json::error::trailing_characters, 5u},
+        {"[-]", json::error::invalid_number, 1u},
+        {"[1..2]", json::error::invalid_number, 1u},
+        {"[1e]", json::error::invalid_number, 1u},
+        {"[01]", json::error::invalid_number, 1u},
+        {"[1x]", json::error::invalid_number, 1u},
+        {"[+1]", json::error::unknown, 1u},
+        {"[e]", json::error::unknown, 1u},
+        {"[.5]", json::error::unknown, 1u},
+        {"[1.]", json::error::invalid_number, 1u},
+        {"[-01]", json::error::invalid_number, 1u},
+        {"[1e+]", json::error::invalid_number, 1u},
+        {"[\"a\tb\"]", json::error::control_character, 3u},
+        {"{\"\n\":1}", json::error::control_character, 2u},
+        {R"(["\q"])", json::error::invalid_escape, 2u},
+        {R"({"\x":1})", json::error::invalid_escape, 2u},
+        {R"(["\u12G4"])", json::error::invalid_unicode, 2u},
+        {R"(["\u12"])", json::error::invalid_unicode, 2u},
+        {R"(["\u12)", json::error::invalid_unicode, 2u},
+        {R"(["\)", json::error::missing_right_quote, 3u},
+    };
+    for (auto& item : strict) {
+        string_t input(item.text);
+        EXPECT_EQ(json::validate(input.begin(), input.end(), &offset), int32_t(item.error))
+            << item.text;
+        EXPECT_EQ(offset, item.offset) << item.text;
+    }
+    for (auto text : {"[0,-0,0.5,-1.25e+10,1E-3,9e9,123]",
+                      "{} \r\n",
+                      R"(["a\tb","\u0001"])",
+                      R"({"\"\\\/\b\f\n\r\t\uD83D\uDE00\u00e9":1})"}) {
+        string_t input(text);
+        EXPECT_EQ(json::validate(input.begin(), input.end()), 0) << text;
+    }
+
+    /* 控制字符在长字符串的后一块中 */
+    string_t raw("[\"");
+    for (int32_t i = 0; i < 100; ++i) {
+        raw << "x";
+    }
+    raw << "\x01\"]";
+    EXPECT_EQ(json::validate(raw.begin(), raw.end(), &offset),
+              int32_t(json::error::control_character));
+    EXPECT_EQ(offset, 102u);
+
+    /* 跨块的 unicode 转义 */
+    string_t unicode("[\"");
+    for (int32_t i = 0; i < 60; ++i) {
+        unicode << "x";
+    }
+    unicode << "\\u00e9\"]";
+    EXPECT_EQ(json::validate(unicode.begin(), unicode.end()), 0);
+    unicode[unicode.size() - 3u] = 'g';
+    EXPECT_EQ(json::validate(unicode.begin(), unicode.end(), &offset),
+              int32_t(json::error::invalid_unicode));
+    EXPECT_EQ(offset, 62u);
+
+    string_t deep;
+    for (size_t i = 0; i <= json::validator<>::max_depth; ++i) {
+        deep << "[";
+    }
+    EXPECT_EQ(json::validate(deep.begin(), deep.end(), &offset),
+              int32_t(json::error::depth_exceeded));
+    EXPECT_EQ(offset, size_t(json::validator<>::max_depth));
+}
+
+template <class JsonType>
+static void json_batch_parse() {
+    using json_type = JsonType;
+    vector_t<string_t> texts(1000u);
+    for (int32_t i = 0; i < 1000; ++i) {
+        string_t text("{\"id\":");
+        text << (i % 100 == 7 ? string_t("tru") : string_t::from(i)) << ",\"s\":\"x\"}";
+        texts.emplace_back(qlib::move(text));
+    }
+    vector_t<string_view_t> inputs(texts.size());
+    for (auto& text : texts) {
+        inputs.emplace_back(text.begin(), text.end());
+    }
+
+    for (uint32_t threads : {1u, 4u}) {
+        json::batch_parser<json_type> batch(threads, json::parse_default, 8u);
+        /* 规模先缩小再扩大, 每次调用回收上一次的文档 */
+        for (size_t size : {size_t(1000u), size_t(100u), size_t(1000u)}) {
+            auto& results = json::parse_batch(batch, inputs.begin(), inputs.begin() + size);
+            EXPECT_EQ(results.size(), size);
+            size_t errors{0u};
+            for (size_t i = 0u; i < results.size(); ++i) {
+                if (i % 100u == 7u) {
+                    EXPECT_NE(results[i].result, 0);
+                    ++errors;
+                    continue;
+                }
+                EXPECT_EQ(results[i].result, 0);
+                auto& object = results[i].value.object();
+                EXPECT_EQ(object[0u].value.template get<size_t>(), i);
+                EXPECT_EQ(object[1u].key, "s");
+            }
+            EXPECT_EQ(errors, size / 100u);
+        }
+        EXPECT_TRUE(batch.parse(inputs.begin(), inputs.begin()).empty());
+    }
+}
+
+TEST(Json, JsonBatchParse) {
+    json_batch_parse<json_pool_t>();
+}
+
+TEST(Json, JsonViewPoolBatchParse) {
+    json_batch_parse<json_view_pool_t>();
+}
+
+TEST(Json, JsonFrozen) {
+    string_t text(R"({"device":"light","args":{"level":3,"on":true},"rooms":["a","b\n"],"n":null})");
+    json_t json;
+    EXPECT_EQ(json::parse(&json, text.begin(), text.end()), 0);
+    json_frozen_t doc(json);
+    EXPECT_EQ(doc.to(), text);
+    EXPECT_EQ(doc.size(), 4u);
+    EXPECT_EQ(doc.key(1u), "args");
+    EXPECT_EQ(doc["args"]["level"].get<int32_t>(), 3);
+    EXPECT_TRUE(doc["args"]["on"].get<bool_t>());
+    EXPECT_EQ(doc["rooms"].at(1u).get<string_view_t>(), "b\\n");
+    EXPECT_EQ(doc["rooms"].at(1u).get<string_t>(), "b\n");
+    EXPECT_TRUE(doc["n"].empty());
+    EXPECT_TRUE(doc["missing"].empty());
+    EXPECT_EQ(doc.resolve(json::pointer<>("/rooms/0")).get<string_view_t>(), "a");
+
+    /* 拷贝与取子树只增加计数 */
+    auto copy = doc;
+    EXPECT_TRUE(copy.same(doc));
+    EXPECT_EQ(doc.use_count(), 2u);
+    auto args = doc["args"];
+    EXPECT_EQ(args.use_count(), 2u);
+
+    /* 修改只复制路径上的结点, 原文档不变 */
+    auto next = doc.set(json::pointer<>("/args/level"), json_frozen_t(json_t(5)));
+    EXPECT_EQ(next["args"]["level"].get<int32_t>(), 5);
+    EXPECT_EQ(doc["args"]["level"].get<int32_t>(), 3);
+    EXPECT_TRUE(next["rooms"].same(doc["rooms"]));
+    EXPECT_TRUE(next["args"]["on"].same(doc["args"]["on"]));
+    EXPECT_FALSE(next["args"].same(doc["args"]));
+    EXPECT_EQ(doc.to(), text);
+
+    next = next.set(json::pointer<>("/rooms/-"), json_frozen_t(json_t("c")));
+    next = next.set(json::pointer<>("/args/color"), doc["rooms"]);
+    next = next.erase(json::pointer<>("/device"));
+    next = next.erase(json::pointer<>("/rooms/0"));
+    EXPECT_EQ(next.to(),
+              R"({"args":{"level":5,"on":true,"color":["a","b\n"]},"rooms":["b\n","c"],"n":null})");
+    EXPECT_TRUE(next["args"]["color"].same(doc["rooms"]));
+    EXPECT_ANY_THROW(next.set(json::pointer<>("/x/y"), json_frozen_t()));
+    EXPECT_ANY_THROW(next.set(json::pointer<>("/rooms/3"), json_frozen_t()));
+    EXPECT_ANY_THROW(next.erase(json::pointer<>("/missing")));
+
+    /* 多线程共享同一个文档 */
+    vector_t<std::thread> threads(4u);
+    for (uint32_t t = 0u; t < 4u; ++t) {
+        threads.emplace_back([&doc]() {
+            for (uint32_t i = 0u; i < 1000u; ++i) {
+                auto local = doc;
+                auto rooms = local["rooms"];
+                EXPECT_EQ(rooms.size(), 2u);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(doc.use_count(), 2u);
+    EXPECT_EQ(doc["rooms"].use_count(), 3u);
+}
+
+template <class JsonType>
+static void json_patch() {
+    using json_type = JsonType;
+    auto load = [](json_type* json, string_t const& text) {
+        return json::parse(json, text.begin(), text.end());
+    };
+    auto dump = [](json_type const& json) {
+        string_t out;
+        json.to(out);
+        return out;
+    };
+
+    typename json_type::allocator_type allocator;
+    json_type doc(allocator);
+    EXPECT_EQ(load(&doc, R"({"a":{"b":[1,2,3]},"c":"x","d~/e":1})"), 0);
+    string_t ops(R"([{"op":"add","path":"/a/b/1","value":9},)"
+                 R"({"op":"add","path":"/a/b/-","value":{"k":"v"}},)"
+                 R"({"op":"remove","path":"/a/b/0"},)"
+                 R"({"op":"replace","path":"/c","value":[true,null]},)"
+                 R"({"op":"move","from":"/d~0~1e","path":"/a/m"},)"
+                 R"({"op":"copy","from":"/a/b/3","path":"/n"},)"
+                 R"({"op":"test","path":"/n/k","value":"v"},)"
+                 R"({"op":"add","path":"/n/k","value":"w"}])");
+    json_t patch;
+    EXPECT_EQ(json::parse(&patch, ops.begin(), ops.end()), 0);
+    EXPECT_EQ(json::apply_patch(&doc, patch), 0);
+    EXPECT_EQ(dump(doc), R"({"a":{"b":[9,2,3,{"k":"v"}],"m":1},"c":[true,null],"n":{"k":"w"}})");
+
+    /* 出错时返回错误码与出错的操作下标 */
+    string_t bad(R"([{"op":"remove","path":"/n"},{"op":"test","path":"/c/0","value":false},)"
+                 R"({"op":"remove","path":"/n"}])");
+    EXPECT_EQ(json::parse(&patch, bad.begin(), bad.end()), 0);
+    size_t failed{0u};
+    EXPECT_EQ(json::apply_patch(&doc, patch, &failed), int32_t(json::error::test_failed));
+    EXPECT_EQ(failed, 1u);
+    for (auto& text : {R"([{"op":"remove","path":"/x"}])",
+                       R"([{"op":"add","path":"/a/b/9","value":1}])",
+                       R"([{"op":"move","from":"/a","path":"/a/b/0"}])",
+                       R"([{"op":"nop","path":""}])", R"([{"op":"add","path":"a"}])", R"({})"}) {
+        string_t input(text);
+        EXPECT_EQ(json::parse(&patch, input.begin(), input.end()), 0);
+        EXPECT_NE(json::apply_patch(&doc, patch), 0);
+    }
+
+    /* RFC 7386 附录中的例子 */
+    json_type target(allocator);
+    EXPECT_EQ(load(&target, R"({"title":"Goodbye!","author":{"givenName":"John",)"
+                            R"("familyName":"Doe"},"tags":["example","sample"],)"
+                            R"("content":"This will be unchanged"})"),
+              0);
+    string_t merge(R"({"title":"Hello!","phoneNumber":"+01-123-456-7890",)"
+                   R"("author":{"familyName":null},"tags":["example"]})");
+    EXPECT_EQ(json::parse(&patch, merge.begin(), merge.end()), 0);
+    json::merge_patch(&target, patch);
+    EXPECT_EQ(dump(target), R"({"title":"Hello!","author":{"givenName":"John"},)"
+                            R"("tags":["example"],"content":"This will be unchanged",)"
+                            R"("phoneNumber":"+01-123-456-7890"})");
+
+    /* diff 的结果应用到原文档上得到目标文档 */
+    json_type from(allocator), to(allocator);
+    EXPECT_EQ(load(&from, R"({"a":[1,2,3],"b":{"c":"x","d/~":1},"e":null})"), 0);
+    EXPECT_EQ(load(&to, R"({"a":[1,5],"b":{"c":"x","d/~":2,"f":[]},"g":true})"), 0);
+    json_t changes;
+    json::diff(&changes, from, to);
+    EXPECT_EQ(changes.array().size(), 6u);
+    EXPECT_EQ(json::apply_patch(&from, changes), 0);
+    EXPECT_TRUE(from == to);
+    json::diff(&changes, from, to);
+    EXPECT_TRUE(changes.array().empty());
+}
+
+TEST(Json, JsonPatch) {
+    json_patch<json_t>();
+}
+
+TEST(Json, JsonPoolPatch) {
+    json_patch<json_pool_t>();
+}
+
+TEST(Json, JsonViewPoolPatch) {
+    /* view 策略的目标: 路径中新增的键复制到目标文档的分配器, 不引用已释放的 pointer */
+    json_view_pool_t::allocator_type allocator;
+    json_view_pool_t doc(allocator);
+    string_t text(R"({"a":{"b":1}})");
+    EXPECT_EQ(json::parse(&doc, text.begin(), text.end()), 0);
+    string_t ops(R"([{"op":"add","path":"/newkey","value":2},)"
+                 R"({"op":"add","path":"/a/q\"~1","value":[3]},)"
+                 R"({"op":"move","from":"/a/b","path":"/moved"}])");
+    json_view_pool_t::allocator_type patch_allocator;
+    json_view_pool_t patch(patch_allocator);
+    EXPECT_EQ(json::parse(&patch, ops.begin(), ops.end()), 0);
+    EXPECT_EQ(json::apply_patch(&doc, patch), 0);
+    EXPECT_EQ(doc["newkey"].get<int32_t>(), 2);
+    EXPECT_EQ(doc["moved"].get<int32_t>(), 1);
+    string_t out;
+    doc.to(out);
+    EXPECT_EQ(out, R"({"a":{"q\"/":[3]},"newkey":2,"moved":1})");
+
+    /* 补丁使用 pool_allocator, 路径的转义在补丁的分配器之外处理 */
+    json_t target;
+    EXPECT_EQ(json::parse(&target, text.begin(), text.end()), 0);
+    json_pool_t::allocator_type pool;
+    json_pool_t pooled(pool);
+    string_t escaped(R"([{"op":"add","path":"/a/\u0063","value":"x"},)"
+                     R"({"op":"remove","path":"/a/b"}])");
+    EXPECT_EQ(json::parse(&pooled, escaped.begin(), escaped.end()), 0);
+    EXPECT_EQ(json::apply_patch(&target, pooled), 0);
+    out.clear();
+    target.to(out);
+    EXPECT_EQ(out, R"({"a":{"c":"x"}})");
+}
+
+template <class JsonType>
+static void json_stream_parser() {
+    using json_type = JsonType;
+    typename json_type::allocator_type allocator;
+    string_t text(R"({"a":[1,-2.5e3,"x\"y\\",true,null,{}],"b":{"c":[]},"s":"abcdefghijklmnop"} )"
+                  R"([false, "z"])"
+                  "\n"
+                  R"({"d": 12345678901234567890})");
+    string_t expected[] = {
+        string_t(R"({"a":[1,-2.5e3,"x\"y\\",true,null,{}],"b":{"c":[]},"s":"abcdefghijklmnop"})"),
+        string_t(R"([false,"z"])"),
+        string_t(R"({"d":12345678901234567890})"),
+    };
+
+    /* 任意分块大小都得到相同的文档 */
+    for (size_t step = 1u; step <= text.size(); ++step) {
+        json::stream_parser<json_type> parser(allocator, json::parse_number_cache);
+        size_t count{0u};
+        auto on_document = [&](json_type& doc) {
+            string_t out;
+            EXPECT_EQ(doc.to(out), expected[count]);
+            ++count;
+        };
+        for (auto first = text.begin(); first < text.end();) {
+            auto last = size_t(text.end() - first) > step ? first + step : text.end();
+            EXPECT_EQ(parser.feed(first, last, on_document), 0);
+            first = last;
+        }
+        EXPECT_EQ(count, 3u);
+        EXPECT_TRUE(parser.empty());
+    }
+
+    json::stream_parser<json_type> parser(allocator);
+    auto ignore = [](json_type&) {};
+    string_t partial(R"({"a":[1,)");
+    EXPECT_EQ(parser.feed(partial.begin(), partial.end(), ignore), 0);
+    EXPECT_FALSE(parser.empty());
+    string_t invalid("tru]}");
+    EXPECT_EQ(parser.feed(invalid.begin(), invalid.end(), ignore),
+              int32_t(json::error::invalid_boolean));
+    parser.reset();
+    EXPECT_TRUE(parser.empty());
+    string_t mismatch(R"({"a":1])");
+    EXPECT_NE(parser.feed(mismatch.begin(), mismatch.end(), ignore), 0);
+}
+
+TEST(Json, JsonStreamParser) {
+    json_stream_parser<json_t>();
+}
+
+TEST(Json, JsonPoolStreamParser) {
+    json_stream_parser<json_pool_t>();
+}
+
+TEST(Json, JsonTape) {
+    string_t text(
+        R"({"a":[1,-2.5e3,"x\"y",true,null,{}],"b":{"c":[]},"s":"abc","n":12345678901234567890})");
+    json_tape_t tape;
+    EXPECT_EQ(json::parse(&tape, text.begin(), text.end()), 0);
+    EXPECT_EQ(tape.type(), json::value_enum::object);
+    EXPECT_EQ(tape.size(), 4u);
+    string_t out;
+    EXPECT_EQ(tape.to(out), text);
+
+    auto a = tape["a"];
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_EQ(a.at(0).get<qlib::int64_t>(), 1);
+    EXPECT_EQ(a.at(1).get<float64_t>(), -2500.0);
+    EXPECT_EQ(a.at(2).get<string_t>(), string_t("x\"y"));
+    EXPECT_TRUE(a.at(3).get<bool_t>());
+    EXPECT_TRUE(a.at(4).empty());
+    EXPECT_EQ(a.at(5).type(), json::value_enum::object);
+    EXPECT_EQ(a.at(5).size(), 0u);
+    EXPECT_TRUE(a.at(6).empty());
+    EXPECT_EQ(tape["b"]["c"].type(), json::value_enum::array);
+    EXPECT_EQ(tape["s"].get<string_view_t>(), "abc");
+    EXPECT_EQ(tape["n"].get<qlib::uint64_t>(), 12345678901234567890ull);
+    EXPECT_TRUE(tape["missing"].empty());
+    EXPECT_EQ(tape["missing"].get<qlib::int64_t>(7), 7);
+
+    /* 跳过子树的遍历结果与 json_view_t 一致 */
+    json_view_t view;
+    EXPECT_EQ(json::parse(&view, text.begin(), text.end()), 0);
+    size_t count{0u};
+    for (auto& item : tape.object()) {
+        string_t expected, actual;
+        view[item.key].to(expected);
+        item.value.to(actual);
+        EXPECT_EQ(actual, expected);
+        ++count;
+    }
+    EXPECT_EQ(count, view.object().size());
+    qlib::int64_t sum{0};
+    for (auto& item : tape["a"].array()) {
+        sum += item.type() == json::value_enum::number_ref ? 1 : 0;
+    }
+    EXPECT_EQ(sum, 2);
+
+    /* 重复解析复用缓冲区, 错误时结果为空 */
+    string_t text2(R"([1,2,3])");
+    EXPECT_EQ(json::parse(&tape, text2.begin(), text2.end()), 0);
+    EXPECT_EQ(tape.size(), 3u);
+    string_t invalid(R"({"a":tru})");
+    EXPECT_EQ(json::parse(&tape, invalid.begin(), invalid.end()),
+              int32_t(json::error::invalid_boolean));
+    EXPECT_TRUE(tape.empty());
+    string_t mismatch(R"({"a":1])");
+    EXPECT_NE(json::parse(&tape, mismatch.begin(), mismatch.end()), 0);
+}
+
+TEST(Json, JsonCompact) {
+    string_t text(R"({"a":[1,-2,3.5,"x\"y",true,null,{}],"b":{"c":[]},"s":"abc",)"
+                  R"("l":"longer than fifteen bytes","n":12345678901234567890})");
+    json_compact_t::allocator_type pool;
+    json_compact_t compact(pool);
+    EXPECT_EQ(json::parse(&compact, text.begin(), text.end()), 0);
+    EXPECT_EQ(compact.type(), json::value_enum::object);
+    EXPECT_EQ(compact.size(), 5u);
+    string_t out;
+    EXPECT_EQ(compact.to(out), text);
+
+    auto& a = compact["a"];
+    EXPECT_EQ(a.size(), 7u);
+    EXPECT_EQ(a.at(1).get<qlib::int64_t>(), -2);
+    EXPECT_EQ(a.at(2).get<float64_t>(), 3.5);
+    EXPECT_EQ(a.at(3).get<string_t>(), string_t("x\"y"));
+    EXPECT_TRUE(a.at(4).get<bool_t>());
+    EXPECT_TRUE(a.at(5).empty());
+    EXPECT_EQ(a.at(6).type(), json::value_enum::object);
+    EXPECT_TRUE(a.at(7).empty());
+    EXPECT_EQ(compact["b"]["c"].type(), json::value_enum::array);
+    EXPECT_EQ(compact["s"].get<string_view_t>(), "abc");
+    EXPECT_EQ(compact["l"].get<string_view_t>(), "longer than fifteen bytes");
+    EXPECT_EQ(compact["n"].get<qlib::uint64_t>(), 12345678901234567890ull);
+    EXPECT_TRUE(compact["missing"].empty());
+    EXPECT_EQ(compact["missing"].get<qlib::int64_t>(7), 7);
+    EXPECT_ANY_THROW((void)compact["s"].get<int32_t>());
+
+    string_t keys;
+    for (auto& item : compact.object()) {
+        keys << item.key.get<string_view_t>();
+    }
+    EXPECT_EQ(keys, "absln");
+
+    /* 每个结点 16 字节, 且不为每个结点保存分配器 */
+    json_view_pool_t::allocator_type view_pool;
+    json_view_pool_t view(view_pool);
+    EXPECT_EQ(json::parse(&view, text.begin(), text.end()), 0);
+    EXPECT_LT(pool.used(), view_pool.used());
+
+    /* 数值按解码结果输出 */
+    string_t numbers(R"([1.0,-0,1e2])");
+    EXPECT_EQ(json::parse(&compact, numbers.begin(), numbers.end()), 0);
+    EXPECT_EQ(compact.to(), "[1,0,100]");
+
+    string_t invalid(R"({"a":tru})");
+    EXPECT_EQ(json::parse(&compact, invalid.begin(), invalid.end()),
+              int32_t(json::error::invalid_boolean));
+    EXPECT_TRUE(compact.empty());
+    string_t mismatch(R"({"a":1])");
+    EXPECT_NE(json::parse(&compact, mismatch.begin(), mismatch.end()), 0);
+}
+
 int32_t main(int32_t argc, char* argv[]) {
     int32_t result{0};
 
@@ -60,6 +60,40 @@ TEST(Json, UniquePtr) {
     EXPECT_NE(*other, test::Object{1u});
 }
 
+TEST(Memory, BigEndian) {
+    uint8_t bytes[8];
+    qlib::memory::store_big_endian(bytes, uint32_t(0x01020304u));
+    EXPECT_EQ(bytes[0], 0x01u);
+    EXPECT_EQ(bytes[3], 0x04u);
+    EXPECT_EQ(qlib::memory::load_big_endian<uint32_t>(bytes), 0x01020304u);
+    qlib::memory::store_big_endian(bytes, qlib::uint64_t(0x0102030405060708ull));
+    EXPECT_EQ(bytes[7], 0x08u);
+    EXPECT_EQ(qlib::memory::load_big_endian<qlib::uint64_t>(bytes), 0x0102030405060708ull);
+    EXPECT_EQ(qlib::memory::byteswap(uint16_t(0x0102u)), 0x0201u);
+}
+
+TEST(Memory, PoolUsed) {
+    qlib::pool_allocator_t pool(64u);
+    EXPECT_EQ(pool.used(), 0u);
+    (void)pool.allocate<uint8_t>(3u);
+    EXPECT_EQ(pool.used(), 8u);
+    /* 超出当前块时链上新块, 统计包含所有块 */
+    (void)pool.allocate<qlib::uint64_t>(16u);
+    EXPECT_EQ(pool.used(), 136u);
+}
+
+TEST(Memory, PoolReset) {
+    qlib::pool_allocator_t pool(64u);
+    (void)pool.allocate<uint8_t>(48u);
+    (void)pool.allocate<uint8_t>(100u);
+    EXPECT_EQ(pool.capacity(), 64u + 128u);
+    pool.reset();
+    EXPECT_EQ(pool.used(), 0u);
+    EXPECT_EQ(pool.capacity(), 192u);
+    (void)pool.allocate<uint8_t>(148u);
+    EXPECT_EQ(pool.capacity(), 192u);
+}
+
 int32_t main(int32_t argc, char* argv[]) {
     int32_t result{0};
 
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "qlib/msgpack.h"
+
+namespace qlib {
+
+static string_t bytes(std::initializer_list<uint8_t> list) {
+    string_t result;
+    for (auto c : list) {
+        result << char(c);
+    }
+    return result;
+}
+
+template <class Json>
+static string_t dump(Json const& json) {
+    string_t result;
+    json.to(result);
+    return result;
+}
+
+TEST(Msgpack, RoundTrip) {
+    string_t text(R"({"a":[1,-1,-33,200,-200,70000,-70000,5000000000,-5000000000,)"
+                  R"(18446744073709551615,-9223372036854775808,1.5],"s":"x\"y\né",)"
+                  R"("t":true,"f":false,"n":null,"e":{},"l":[]})");
+    json_t json;
+    EXPECT_EQ(json::parse(&json, text.begin(), text.end()), 0);
+    auto expected = dump(json);
+
+    string_t binary;
+    msgpack::to(json, binary);
+    json_t copy;
+    EXPECT_EQ(msgpack::parse(&copy, binary.begin(), binary.end()), 0);
+    EXPECT_EQ(dump(copy), expected);
+    EXPECT_EQ(copy["s"].get<string_t>(), "x\"y\n\xc3\xa9");
+
+    /* view 策略: 不需要转义的字符串直接指向输入, 需要转义的从 pool 分配 */
+    json_view_pool_t::allocator_type pool;
+    json_view_pool_t view(pool);
+    EXPECT_EQ(msgpack::parse(&view, binary.begin(), binary.end()), 0);
+    EXPECT_EQ(dump(view), expected);
+    auto key = view.object()[0u].key;
+    EXPECT_TRUE(key.data() >= binary.begin() && key.data() < binary.end());
+}
+
+TEST(Msgpack, Format) {
+    auto input = bytes({0x83, 0xA1, 'a', 0xCC, 0xC8, 0xA1, 'b', 0xD1, 0xFF, 0x38, 0xA1, 'c',
+                        0x92, 0xC3, 0xC0});
+    json_t json;
+    EXPECT_EQ(msgpack::parse(&json, input.begin(), input.end()), 0);
+    EXPECT_EQ(dump(json), R"({"a":200,"b":-200,"c":[true,null]})");
+
+    string_t output;
+    msgpack::to(json, output);
+    EXPECT_EQ(output, input);
+
+    /* bin 在文本中输出为字节数组 */
+    static char const raw[] = "\x00\xff\x10";
+    auto blob = json_t::binary(string_view_t(raw, raw + 3), json.allocator());
+    output.clear();
+    msgpack::to(blob, output);
+    EXPECT_EQ(output, bytes({0xC4, 0x03, 0x00, 0xFF, 0x10}));
+    EXPECT_EQ(msgpack::parse(&json, output.begin(), output.end()), 0);
+    EXPECT_EQ(json.binary(), string_view_t(raw, raw + 3));
+    EXPECT_EQ(dump(json), "[0,255,16]");
+
+    /* 截断, ext, 非字符串的键与多余的数据 */
+    for (auto& bad : {bytes({0xCD, 0x01}), bytes({0xD4, 0x01, 0x02}), bytes({0x81, 0x01, 0x02}),
+                      bytes({0xDD, 0xFF, 0xFF, 0xFF, 0xFF}), bytes({0x01, 0x02})}) {
+        EXPECT_EQ(msgpack::parse(&json, bad.begin(), bad.end()),
+                  int32_t(msgpack::error::invalid_binary));
+        EXPECT_TRUE(json.type() == json::value_enum::null);
+    }
+}
+
+};  // namespace qlib
+
+int32_t main(int32_t argc, char* argv[]) {
+    int32_t result{0};
+
+    do {
+        testing::InitGoogleTest(&argc, argv);
+        result = RUN_ALL_TESTS();
+    } while (false);
+
+    return result;
+}
@@ -139,6 +139,51 @@ TEST(Json, StringStack) {
     EXPECT_EQ(str2, text2);
 }
 
+TEST(Json, StringFromFloatShortest) {
+    using string_t = string_t;
+    EXPECT_EQ(string_t::from(float64_t(0.1)), "0.1");
+    EXPECT_EQ(string_t::from(float64_t(-1234.5e-10)), "-1.2345e-07");
+    EXPECT_EQ(string_t::from(float32_t(3.4028235e38f)), "3.4028235e+38");
+    EXPECT_EQ(string_t::from(float64_t(1.5), 3u), "1.500");
+
+    char str[32];
+    auto last = string::to_chars(str, str + sizeof(str), 5e-324);
+    EXPECT_EQ(string_view_t(str, last), "5e-324");
+    last = string::to_chars(str, str + sizeof(str), 1e21,
+                                  string::chars_format::scientific);
+    EXPECT_EQ(string_view_t(str, last), "1e+21");
+    last = string::to_chars(str, str + sizeof(str), 1.0 / 3,
+                                  string::chars_format::general, 5u);
+    EXPECT_EQ(string_view_t(str, last), "0.33333");
+}
+
+TEST(Json, StringFromChars) {
+    auto parse = [](char const* s) {
+        float64_t value{0};
+        auto last = s + __builtin_strlen(s);
+        EXPECT_EQ(string::from_chars(s, last, value), last) << s;
+        return value;
+    };
+    EXPECT_EQ(parse("0"), 0.0);
+    EXPECT_EQ(parse("-1.5"), -1.5);
+    EXPECT_EQ(parse("0.1"), 0.1);
+    EXPECT_EQ(parse("3231.123456"), 3231.123456);
+    EXPECT_EQ(parse("1.7976931348623157e308"), 1.7976931348623157e308);
+    EXPECT_EQ(parse("2.2250738585072011e-308"), 2.2250738585072011e-308);
+    EXPECT_EQ(parse("4.9e-324"), 4.9e-324);
+    EXPECT_EQ(parse("1e-400"), 0.0);
+    EXPECT_EQ(parse("9007199254740993"), 9007199254740992.0);
+    EXPECT_EQ(parse("9007199254740993.0000000000000000001"), 9007199254740994.0);
+    EXPECT_EQ(parse("123456789012345678901234567890e-10"), 123456789012345678901234567890e-10);
+
+    float32_t value{0};
+    char const text[] = "3.4028235e38,";
+    EXPECT_EQ(string::from_chars(text, text + sizeof(text) - 1, value), text + 12);
+    EXPECT_EQ(value, 3.4028235e38f);
+    char const bad[] = "-.e5";
+    EXPECT_EQ(string::from_chars(bad, bad + sizeof(bad) - 1, value), bad);
+}
+
 int32_t main(int32_t argc, char* argv[]) {
     int32_t result{0};
 
@@ -16,6 +16,9 @@ TEST(Json, Vector) {
         EXPECT_EQ(value, size);
         size++;
     }
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), 256u);
 }
 
 TEST(Json, VectorPool) {